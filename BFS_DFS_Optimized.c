@@ -3,6 +3,8 @@
 #include <stdbool.h>
 #include <string.h>
 
+#include "MemoryPool.h"
+
 #define MAX_VERTICES 100
 #define QUEUE_SIZE 100
 
@@ -16,6 +18,7 @@ typedef struct Graph {
     int num_vertices;
     Node** adj_list;
     bool* visited;
+    NodePool edge_pool;  // Adjacency list nodes, see MemoryPool.h
 } Graph;
 
 // Queue for BFS
@@ -164,12 +167,13 @@ Graph* create_graph(int vertices) {
         return NULL;
     }
     
+    pool_init(&graph->edge_pool, sizeof(Node));
     return graph;
 }
 
 void add_edge(Graph* graph, int src, int dest) {
     // Add edge from src to dest
-    Node* new_node = (Node*)malloc(sizeof(Node));
+    Node* new_node = (Node*)pool_alloc(&graph->edge_pool);
     if (!new_node) return;
     
     new_node->vertex = dest;
@@ -177,7 +181,7 @@ void add_edge(Graph* graph, int src, int dest) {
     graph->adj_list[src] = new_node;
     
     // For undirected graph, add edge from dest to src
-    new_node = (Node*)malloc(sizeof(Node));
+    new_node = (Node*)pool_alloc(&graph->edge_pool);
     if (!new_node) return;
     
     new_node->vertex = src;
@@ -281,15 +285,19 @@ void reset_visited(Graph* graph) {
 void free_graph(Graph* graph) {
     if (!graph) return;
     
-    for (int i = 0; i < graph->num_vertices; i++) {
-        Node* current = graph->adj_list[i];
-        while (current) {
-            Node* temp = current;
-            current = current->next;
-            free(temp);
+    // Pooled edges are released with their blocks
+    if (!pool_owns_nodes(&graph->edge_pool)) {
+        for (int i = 0; i < graph->num_vertices; i++) {
+            Node* current = graph->adj_list[i];
+            while (current) {
+                Node* temp = current;
+                current = current->next;
+                pool_free(&graph->edge_pool, temp);
+            }
         }
     }
     
+    pool_destroy(&graph->edge_pool);
     free(graph->adj_list);
     free(graph->visited);
     free(graph);
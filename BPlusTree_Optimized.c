@@ -0,0 +1,868 @@
+// Cache-conscious B+-tree index over int keys, with the same operations
+// as BinarySearchTree_Optimized.c and a head-to-head benchmark against it.
+//
+// Build:
+//   gcc -std=c99 -Wall -Wextra -O2 BPlusTree_Optimized.c -o bplus_tree
+//
+// Every node is 256 bytes (four cache lines) and 64-byte aligned. A leaf
+// holds up to 60 sorted keys and a pointer to the next leaf, so range
+// scans walk the leaf chain without returning to the root. An internal
+// node holds up to 20 separator keys and 21 children: child i holds keys
+// below keys[i], child i + 1 keys from keys[i] up. A lookup touches one
+// node per level, and with a fanout of 21 a 100M-key tree is 7 levels
+// deep against about 27 for a balanced binary tree.
+//
+// Deletion borrows from or merges with a sibling whenever a node falls
+// below half full, so every node except the root stays at least half
+// full.
+
+#define _POSIX_C_SOURCE 200809L
+
+#define BST_NO_MAIN
+#include "BinarySearchTree_Optimized.c"
+
+#include <stdint.h>
+#include <string.h>
+
+#define BPT_NODE_SIZE 256
+#define BPT_LEAF_KEYS 60
+#define BPT_INTERNAL_KEYS 20
+#define BPT_LEAF_MIN (BPT_LEAF_KEYS / 2)
+#define BPT_INTERNAL_MIN (BPT_INTERNAL_KEYS / 2)
+#define BPT_BENCH_LOOKUPS 1000000
+#define BPT_BENCH_RANGES 10000
+#define BPT_BENCH_RANGE_WIDTH 1000000
+
+// Common header: a node is a BPTLeaf or a BPTInternal depending on is_leaf
+typedef struct BPTNode {
+    int is_leaf;
+    int count;  // Keys in use
+} BPTNode;
+
+typedef struct BPTLeaf {
+    BPTNode header;
+    int keys[BPT_LEAF_KEYS];
+    struct BPTLeaf* next;  // Next leaf in key order, NULL for the last
+} BPTLeaf;
+
+typedef struct {
+    BPTNode header;
+    int keys[BPT_INTERNAL_KEYS];
+    BPTNode* children[BPT_INTERNAL_KEYS + 1];
+} BPTInternal;
+
+typedef struct {
+    BPTNode* root;       // Always a node; an empty tree is an empty leaf
+    BPTLeaf* first_leaf;
+    long size;
+    int height;          // Levels, 1 for a lone leaf
+    long leaf_count;
+    long internal_count;
+} BPlusTree;
+
+// Function prototypes
+BPlusTree* bpt_create();
+void bpt_free(BPlusTree* tree);
+void bpt_free_node(BPTNode* node);
+BPTNode* bpt_alloc_node(BPlusTree* tree, bool is_leaf);
+void bpt_release_node(BPlusTree* tree, BPTNode* node);
+bool bpt_insert(BPlusTree* tree, int key);
+int bpt_insert_into(BPlusTree* tree, BPTNode* node, int key, int* up_key, BPTNode** up_node);
+bool bpt_delete(BPlusTree* tree, int key);
+bool bpt_delete_from(BPlusTree* tree, BPTNode* node, int key);
+void bpt_fix_child(BPlusTree* tree, BPTInternal* parent, int index);
+bool bpt_search(BPlusTree* tree, int key);
+BPTLeaf* bpt_find_leaf(BPlusTree* tree, int key);
+int bpt_lower_bound(const int keys[], int count, int key);
+int bpt_upper_bound(const int keys[], int count, int key);
+long bpt_range_scan(BPlusTree* tree, int low, int high, int out[], long max_out);
+long bpt_range_count(BPlusTree* tree, int low, int high);
+bool bpt_min(BPlusTree* tree, int* key);
+bool bpt_max(BPlusTree* tree, int* key);
+bool bpt_is_valid(BPlusTree* tree);
+bool bpt_is_valid_node(BPTNode* node, int depth, int height, long long low, long long high,
+                       bool is_root, long* keys_seen);
+void bpt_print_keys(BPlusTree* tree);
+void bpt_print_info(BPlusTree* tree);
+void benchmark_bpt_vs_bst(int max_keys);
+long random_index(long n);
+
+#ifndef BPT_NO_MAIN
+int main() {
+    BPlusTree* tree = bpt_create();
+    int choice, value, high;
+    
+    if (!tree) {
+        printf("Memory allocation failed!\n");
+        return 1;
+    }
+    
+    printf("=== Cache-Conscious B+-Tree ===\n");
+    srand(time(NULL));
+    
+    while (1) {
+        printf("\n=== B+-TREE OPERATIONS MENU ===\n");
+        printf("1.  Insert\n");
+        printf("2.  Delete\n");
+        printf("3.  Search\n");
+        printf("4.  Range Scan\n");
+        printf("5.  Display Keys (leaf chain)\n");
+        printf("6.  Tree Statistics\n");
+        printf("7.  Validate Tree\n");
+        printf("8.  Clear Tree\n");
+        printf("9.  B+-Tree vs BST Benchmark\n");
+        printf("10. Exit\n");
+        printf("Enter your choice: ");
+        
+        if (scanf("%d", &choice) != 1) {
+            printf("Invalid input!\n");
+            while (getchar() != '\n');
+            continue;
+        }
+        
+        switch (choice) {
+            case 1:
+                printf("Enter value to insert: ");
+                if (scanf("%d", &value) == 1) {
+                    if (bpt_insert(tree, value)) {
+                        printf("Value %d inserted successfully.\n", value);
+                    } else {
+                        printf("Value %d already present or out of memory.\n", value);
+                    }
+                } else {
+                    printf("Invalid input!\n");
+                    while (getchar() != '\n');
+                }
+                break;
+            
+            case 2:
+                printf("Enter value to delete: ");
+                if (scanf("%d", &value) == 1) {
+                    printf("Value %d %s.\n", value,
+                           bpt_delete(tree, value) ? "deleted successfully" : "not found");
+                } else {
+                    printf("Invalid input!\n");
+                    while (getchar() != '\n');
+                }
+                break;
+            
+            case 3:
+                printf("Enter value to search: ");
+                if (scanf("%d", &value) == 1) {
+                    bool found;
+                    PERF_MEASURE("bpt_search", 1, found = bpt_search(tree, value));
+                    printf("Value %d %s in the tree.\n", value, found ? "found" : "not found");
+                } else {
+                    printf("Invalid input!\n");
+                    while (getchar() != '\n');
+                }
+                break;
+            
+            case 4: {
+                printf("Enter low and high bounds: ");
+                if (scanf("%d %d", &value, &high) != 2 || value > high) {
+                    printf("Invalid range!\n");
+                    while (getchar() != '\n');
+                    break;
+                }
+                
+                int shown[20];
+                long total = bpt_range_count(tree, value, high);
+                long count = bpt_range_scan(tree, value, high, shown, 20);
+                printf("%ld keys in [%d, %d]:", total, value, high);
+                for (long i = 0; i < count; i++) {
+                    printf(" %d", shown[i]);
+                }
+                printf("%s\n", total > count ? " ..." : "");
+                break;
+            }
+            
+            case 5:
+                bpt_print_keys(tree);
+                break;
+            
+            case 6:
+                bpt_print_info(tree);
+                break;
+            
+            case 7:
+                printf("Tree is %s valid B+-tree.\n", bpt_is_valid(tree) ? "a" : "not a");
+                break;
+            
+            case 8:
+                bpt_free(tree);
+                tree = bpt_create();
+                if (!tree) {
+                    printf("Memory allocation failed!\n");
+                    return 1;
+                }
+                printf("Tree cleared successfully.\n");
+                break;
+            
+            case 9:
+                printf("Enter largest key count (1000000 to 100000000): ");
+                if (scanf("%d", &value) == 1 && value >= 1000000 && value <= 100000000) {
+                    benchmark_bpt_vs_bst(value);
+                } else {
+                    printf("Invalid size!\n");
+                    while (getchar() != '\n');
+                }
+                break;
+            
+            case 10:
+                bpt_free(tree);
+                printf("Exiting program...\n");
+                return 0;
+            
+            default:
+                printf("Invalid choice! Please try again.\n");
+        }
+    }
+    
+    return 0;
+}
+#endif
+
+BPlusTree* bpt_create() {
+    BPlusTree* tree = (BPlusTree*)malloc(sizeof(BPlusTree));
+    if (!tree) return NULL;
+    
+    tree->size = 0;
+    tree->height = 1;
+    tree->leaf_count = 0;
+    tree->internal_count = 0;
+    tree->root = bpt_alloc_node(tree, true);
+    if (!tree->root) {
+        free(tree);
+        return NULL;
+    }
+    tree->first_leaf = (BPTLeaf*)tree->root;
+    
+    return tree;
+}
+
+void bpt_free(BPlusTree* tree) {
+    if (tree) {
+        bpt_free_node(tree->root);
+        free(tree);
+    }
+}
+
+// Recursion depth is the tree height, at most a handful of levels
+void bpt_free_node(BPTNode* node) {
+    if (!node->is_leaf) {
+        BPTInternal* internal = (BPTInternal*)node;
+        for (int i = 0; i <= node->count; i++) {
+            bpt_free_node(internal->children[i]);
+        }
+    }
+    free(node);
+}
+
+// Nodes start on a cache line so each one spans exactly four lines
+BPTNode* bpt_alloc_node(BPlusTree* tree, bool is_leaf) {
+    void* memory = NULL;
+    if (posix_memalign(&memory, 64, BPT_NODE_SIZE) != 0) return NULL;
+    
+    BPTNode* node = (BPTNode*)memory;
+    node->is_leaf = is_leaf;
+    node->count = 0;
+    
+    if (is_leaf) {
+        ((BPTLeaf*)node)->next = NULL;
+        tree->leaf_count++;
+    } else {
+        tree->internal_count++;
+    }
+    
+    return node;
+}
+
+void bpt_release_node(BPlusTree* tree, BPTNode* node) {
+    if (node->is_leaf) {
+        tree->leaf_count--;
+    } else {
+        tree->internal_count--;
+    }
+    free(node);
+}
+
+// First index whose key is >= key
+int bpt_lower_bound(const int keys[], int count, int key) {
+    int low = 0, high = count;
+    
+    while (low < high) {
+        int mid = (low + high) / 2;
+        if (keys[mid] < key) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    
+    return low;
+}
+
+// First index whose key is > key, which is also the child to descend into
+int bpt_upper_bound(const int keys[], int count, int key) {
+    int low = 0, high = count;
+    
+    while (low < high) {
+        int mid = (low + high) / 2;
+        if (keys[mid] <= key) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    
+    return low;
+}
+
+BPTLeaf* bpt_find_leaf(BPlusTree* tree, int key) {
+    BPTNode* node = tree->root;
+    
+    while (!node->is_leaf) {
+        BPTInternal* internal = (BPTInternal*)node;
+        node = internal->children[bpt_upper_bound(internal->keys, node->count, key)];
+    }
+    
+    return (BPTLeaf*)node;
+}
+
+bool bpt_search(BPlusTree* tree, int key) {
+    BPTLeaf* leaf = bpt_find_leaf(tree, key);
+    int pos = bpt_lower_bound(leaf->keys, leaf->header.count, key);
+    
+    return pos < leaf->header.count && leaf->keys[pos] == key;
+}
+
+// Returns false if the key is already present (no duplicates, as in the
+// BST) or memory runs out; the tree is unchanged in both cases
+bool bpt_insert(BPlusTree* tree, int key) {
+    int up_key;
+    BPTNode* up_node;
+    int max_keys = tree->root->is_leaf ? BPT_LEAF_KEYS : BPT_INTERNAL_KEYS;
+    BPTInternal* root = NULL;
+    
+    // A full root may split, and its new parent must exist before then
+    if (tree->root->count == max_keys) {
+        root = (BPTInternal*)bpt_alloc_node(tree, false);
+        if (!root) return false;
+    }
+    
+    int status = bpt_insert_into(tree, tree->root, key, &up_key, &up_node);
+    
+    if (status != 2 && root) {
+        bpt_release_node(tree, (BPTNode*)root);
+    } else if (status == 2) {
+        // The root split: grow the tree by one level
+        root->header.count = 1;
+        root->keys[0] = up_key;
+        root->children[0] = tree->root;
+        root->children[1] = up_node;
+        tree->root = (BPTNode*)root;
+        tree->height++;
+    }
+    
+    if (status > 0) tree->size++;
+    return status > 0;
+}
+
+// Inserts below node. Returns 0 for a duplicate, -1 when out of memory,
+// 1 when done, or 2 when node split: up_node is then the new right
+// sibling and up_key the separator to insert into the parent. A full
+// internal node allocates its split sibling before descending, so a
+// failed allocation never leaves a split child without a parent entry.
+int bpt_insert_into(BPlusTree* tree, BPTNode* node, int key, int* up_key, BPTNode** up_node) {
+    if (node->is_leaf) {
+        BPTLeaf* leaf = (BPTLeaf*)node;
+        int pos = bpt_lower_bound(leaf->keys, node->count, key);
+        if (pos < node->count && leaf->keys[pos] == key) return 0;
+        
+        if (node->count < BPT_LEAF_KEYS) {
+            memmove(&leaf->keys[pos + 1], &leaf->keys[pos], (node->count - pos) * sizeof(int));
+            leaf->keys[pos] = key;
+            node->count++;
+            return 1;
+        }
+        
+        BPTLeaf* right = (BPTLeaf*)bpt_alloc_node(tree, true);
+        if (!right) return -1;
+        
+        // Split the BPT_LEAF_KEYS + 1 keys in half, the new key included
+        int all[BPT_LEAF_KEYS + 1];
+        memcpy(all, leaf->keys, pos * sizeof(int));
+        all[pos] = key;
+        memcpy(&all[pos + 1], &leaf->keys[pos], (BPT_LEAF_KEYS - pos) * sizeof(int));
+        
+        int left_count = (BPT_LEAF_KEYS + 1) / 2;
+        memcpy(leaf->keys, all, left_count * sizeof(int));
+        memcpy(right->keys, &all[left_count], (BPT_LEAF_KEYS + 1 - left_count) * sizeof(int));
+        node->count = left_count;
+        right->header.count = BPT_LEAF_KEYS + 1 - left_count;
+        
+        right->next = leaf->next;
+        leaf->next = right;
+        
+        *up_key = right->keys[0];
+        *up_node = (BPTNode*)right;
+        return 2;
+    }
+    
+    BPTInternal* internal = (BPTInternal*)node;
+    BPTInternal* right = NULL;
+    if (node->count == BPT_INTERNAL_KEYS) {
+        right = (BPTInternal*)bpt_alloc_node(tree, false);
+        if (!right) return -1;
+    }
+    
+    int index = bpt_upper_bound(internal->keys, node->count, key);
+    int child_key;
+    BPTNode* child_node;
+    int status = bpt_insert_into(tree, internal->children[index], key, &child_key, &child_node);
+    if (status != 2) {
+        if (right) bpt_release_node(tree, (BPTNode*)right);
+        return status;
+    }
+    
+    if (node->count < BPT_INTERNAL_KEYS) {
+        memmove(&internal->keys[index + 1], &internal->keys[index],
+                (node->count - index) * sizeof(int));
+        memmove(&internal->children[index + 2], &internal->children[index + 1],
+                (node->count - index) * sizeof(BPTNode*));
+        internal->keys[index] = child_key;
+        internal->children[index + 1] = child_node;
+        node->count++;
+        return 1;
+    }
+    
+    // Split BPT_INTERNAL_KEYS + 1 keys: the middle one moves up
+    int keys[BPT_INTERNAL_KEYS + 1];
+    BPTNode* children[BPT_INTERNAL_KEYS + 2];
+    memcpy(keys, internal->keys, index * sizeof(int));
+    keys[index] = child_key;
+    memcpy(&keys[index + 1], &internal->keys[index], (BPT_INTERNAL_KEYS - index) * sizeof(int));
+    memcpy(children, internal->children, (index + 1) * sizeof(BPTNode*));
+    children[index + 1] = child_node;
+    memcpy(&children[index + 2], &internal->children[index + 1],
+           (BPT_INTERNAL_KEYS - index) * sizeof(BPTNode*));
+    
+    int left_count = BPT_INTERNAL_KEYS / 2;
+    int right_count = BPT_INTERNAL_KEYS - left_count;
+    memcpy(internal->keys, keys, left_count * sizeof(int));
+    memcpy(internal->children, children, (left_count + 1) * sizeof(BPTNode*));
+    memcpy(right->keys, &keys[left_count + 1], right_count * sizeof(int));
+    memcpy(right->children, &children[left_count + 1], (right_count + 1) * sizeof(BPTNode*));
+    node->count = left_count;
+    right->header.count = right_count;
+    
+    *up_key = keys[left_count];
+    *up_node = (BPTNode*)right;
+    return 2;
+}
+
+bool bpt_delete(BPlusTree* tree, int key) {
+    if (!bpt_delete_from(tree, tree->root, key)) return false;
+    
+    tree->size--;
+    
+    // An internal root left with a single child hands over to it
+    if (!tree->root->is_leaf && tree->root->count == 0) {
+        BPTNode* old_root = tree->root;
+        tree->root = ((BPTInternal*)old_root)->children[0];
+        bpt_release_node(tree, old_root);
+        tree->height--;
+    }
+    
+    return true;
+}
+
+// Removes key below node, then repairs any child left under half full
+bool bpt_delete_from(BPlusTree* tree, BPTNode* node, int key) {
+    if (node->is_leaf) {
+        BPTLeaf* leaf = (BPTLeaf*)node;
+        int pos = bpt_lower_bound(leaf->keys, node->count, key);
+        if (pos == node->count || leaf->keys[pos] != key) return false;
+        
+        memmove(&leaf->keys[pos], &leaf->keys[pos + 1], (node->count - pos - 1) * sizeof(int));
+        node->count--;
+        return true;
+    }
+    
+    BPTInternal* internal = (BPTInternal*)node;
+    int index = bpt_upper_bound(internal->keys, node->count, key);
+    BPTNode* child = internal->children[index];
+    
+    if (!bpt_delete_from(tree, child, key)) return false;
+    
+    int min = child->is_leaf ? BPT_LEAF_MIN : BPT_INTERNAL_MIN;
+    if (child->count < min) {
+        bpt_fix_child(tree, internal, index);
+    }
+    
+    return true;
+}
+
+// Child index of parent has one key too few: borrow a key from a sibling
+// with spare keys, otherwise merge with a sibling. Separators left behind
+// by deleted keys stay valid bounds, so they are only rewritten here.
+void bpt_fix_child(BPlusTree* tree, BPTInternal* parent, int index) {
+    BPTNode* child = parent->children[index];
+    BPTNode* left = index > 0 ? parent->children[index - 1] : NULL;
+    BPTNode* right = index < parent->header.count ? parent->children[index + 1] : NULL;
+    int min = child->is_leaf ? BPT_LEAF_MIN : BPT_INTERNAL_MIN;
+    
+    if (child->is_leaf) {
+        BPTLeaf* leaf = (BPTLeaf*)child;
+        
+        if (left && left->count > min) {
+            BPTLeaf* donor = (BPTLeaf*)left;
+            memmove(&leaf->keys[1], leaf->keys, child->count * sizeof(int));
+            leaf->keys[0] = donor->keys[--left->count];
+            child->count++;
+            parent->keys[index - 1] = leaf->keys[0];
+            return;
+        }
+        
+        if (right && right->count > min) {
+            BPTLeaf* donor = (BPTLeaf*)right;
+            leaf->keys[child->count++] = donor->keys[0];
+            memmove(donor->keys, &donor->keys[1], (right->count - 1) * sizeof(int));
+            right->count--;
+            parent->keys[index] = donor->keys[0];
+            return;
+        }
+        
+        // Merge the right node of the pair into the left one
+        if (left) {
+            index--;
+            right = child;
+            child = left;
+        }
+        BPTLeaf* into = (BPTLeaf*)child;
+        BPTLeaf* from = (BPTLeaf*)right;
+        memcpy(&into->keys[child->count], from->keys, right->count * sizeof(int));
+        child->count += right->count;
+        into->next = from->next;
+    } else {
+        BPTInternal* node = (BPTInternal*)child;
+        
+        if (left && left->count > min) {
+            BPTInternal* donor = (BPTInternal*)left;
+            memmove(&node->keys[1], node->keys, child->count * sizeof(int));
+            memmove(&node->children[1], node->children, (child->count + 1) * sizeof(BPTNode*));
+            node->keys[0] = parent->keys[index - 1];
+            node->children[0] = donor->children[left->count];
+            parent->keys[index - 1] = donor->keys[left->count - 1];
+            left->count--;
+            child->count++;
+            return;
+        }
+        
+        if (right && right->count > min) {
+            BPTInternal* donor = (BPTInternal*)right;
+            node->keys[child->count] = parent->keys[index];
+            node->children[child->count + 1] = donor->children[0];
+            child->count++;
+            parent->keys[index] = donor->keys[0];
+            memmove(donor->keys, &donor->keys[1], (right->count - 1) * sizeof(int));
+            memmove(donor->children, &donor->children[1], right->count * sizeof(BPTNode*));
+            right->count--;
+            return;
+        }
+        
+        if (left) {
+            index--;
+            right = child;
+            child = left;
+        }
+        BPTInternal* into = (BPTInternal*)child;
+        BPTInternal* from = (BPTInternal*)right;
+        into->keys[child->count] = parent->keys[index];
+        memcpy(&into->keys[child->count + 1], from->keys, right->count * sizeof(int));
+        memcpy(&into->children[child->count + 1], from->children,
+               (right->count + 1) * sizeof(BPTNode*));
+        child->count += right->count + 1;
+    }
+    
+    // Drop the separator and the emptied right node from the parent
+    memmove(&parent->keys[index], &parent->keys[index + 1],
+            (parent->header.count - index - 1) * sizeof(int));
+    memmove(&parent->children[index + 1], &parent->children[index + 2],
+            (parent->header.count - index - 1) * sizeof(BPTNode*));
+    parent->header.count--;
+    bpt_release_node(tree, right);
+}
+
+// Copies keys in [low, high] into out (at most max_out of them) by
+// walking the leaf chain, and returns how many were copied
+long bpt_range_scan(BPlusTree* tree, int low, int high, int out[], long max_out) {
+    if (low > high) return 0;
+    
+    BPTLeaf* leaf = bpt_find_leaf(tree, low);
+    int pos = bpt_lower_bound(leaf->keys, leaf->header.count, low);
+    long count = 0;
+    
+    while (leaf && count < max_out) {
+        for (; pos < leaf->header.count && count < max_out; pos++) {
+            if (leaf->keys[pos] > high) return count;
+            out[count++] = leaf->keys[pos];
+        }
+        leaf = leaf->next;
+        pos = 0;
+    }
+    
+    return count;
+}
+
+// Counts keys in [low, high]; whole leaves inside the range are counted
+// without looking at their keys
+long bpt_range_count(BPlusTree* tree, int low, int high) {
+    if (low > high) return 0;
+    
+    BPTLeaf* leaf = bpt_find_leaf(tree, low);
+    int pos = bpt_lower_bound(leaf->keys, leaf->header.count, low);
+    long count = 0;
+    
+    while (leaf) {
+        int n = leaf->header.count;
+        if (n > 0 && leaf->keys[n - 1] <= high) {
+            count += n - pos;
+        } else {
+            return count + bpt_upper_bound(leaf->keys, n, high) - pos;
+        }
+        leaf = leaf->next;
+        pos = 0;
+    }
+    
+    return count;
+}
+
+bool bpt_min(BPlusTree* tree, int* key) {
+    if (tree->size == 0) return false;
+    
+    // Only a root leaf can be empty, and then the tree has no keys
+    *key = tree->first_leaf->keys[0];
+    return true;
+}
+
+bool bpt_max(BPlusTree* tree, int* key) {
+    if (tree->size == 0) return false;
+    
+    BPTNode* node = tree->root;
+    while (!node->is_leaf) {
+        node = ((BPTInternal*)node)->children[node->count];
+    }
+    *key = ((BPTLeaf*)node)->keys[node->count - 1];
+    return true;
+}
+
+// Checks key order, separator bounds, fill factors, uniform leaf depth,
+// the leaf chain and the key count
+bool bpt_is_valid(BPlusTree* tree) {
+    long keys_seen = 0;
+    if (!bpt_is_valid_node(tree->root, 1, tree->height, (long long)INT_MIN - 1,
+                           (long long)INT_MAX + 1, true, &keys_seen)) {
+        return false;
+    }
+    if (keys_seen != tree->size) return false;
+    
+    long chained = 0;
+    long long previous = (long long)INT_MIN - 1;
+    for (BPTLeaf* leaf = tree->first_leaf; leaf; leaf = leaf->next) {
+        for (int i = 0; i < leaf->header.count; i++) {
+            if (leaf->keys[i] <= previous) return false;
+            previous = leaf->keys[i];
+        }
+        chained += leaf->header.count;
+    }
+    
+    return chained == tree->size;
+}
+
+// Keys under node must lie in [low, high)
+bool bpt_is_valid_node(BPTNode* node, int depth, int height, long long low, long long high,
+                       bool is_root, long* keys_seen) {
+    if (node->is_leaf) {
+        BPTLeaf* leaf = (BPTLeaf*)node;
+        if (depth != height || node->count > BPT_LEAF_KEYS) return false;
+        if (!is_root && node->count < BPT_LEAF_MIN) return false;
+        
+        for (int i = 0; i < node->count; i++) {
+            if (leaf->keys[i] < low || leaf->keys[i] >= high) return false;
+            if (i > 0 && leaf->keys[i] <= leaf->keys[i - 1]) return false;
+        }
+        *keys_seen += node->count;
+        return true;
+    }
+    
+    BPTInternal* internal = (BPTInternal*)node;
+    if (node->count > BPT_INTERNAL_KEYS || node->count < (is_root ? 1 : BPT_INTERNAL_MIN)) {
+        return false;
+    }
+    
+    for (int i = 0; i <= node->count; i++) {
+        long long child_low = i == 0 ? low : internal->keys[i - 1];
+        long long child_high = i == node->count ? high : internal->keys[i];
+        if (child_low > child_high) return false;
+        if (!bpt_is_valid_node(internal->children[i], depth + 1, height, child_low, child_high,
+                               false, keys_seen)) {
+            return false;
+        }
+    }
+    
+    return true;
+}
+
+void bpt_print_keys(BPlusTree* tree) {
+    if (tree->size == 0) {
+        printf("Tree is empty!\n");
+        return;
+    }
+    
+    printf("Keys (leaf chain):");
+    for (BPTLeaf* leaf = tree->first_leaf; leaf; leaf = leaf->next) {
+        printf(" [");
+        for (int i = 0; i < leaf->header.count; i++) {
+            printf(i ? " %d" : "%d", leaf->keys[i]);
+        }
+        printf("]");
+    }
+    printf("\n");
+}
+
+void bpt_print_info(BPlusTree* tree) {
+    int min_key, max_key;
+    long bytes = (tree->leaf_count + tree->internal_count) * BPT_NODE_SIZE;
+    
+    printf("\n=== Tree Statistics ===\n");
+    printf("Keys: %ld\n", tree->size);
+    printf("Height: %d\n", tree->height);
+    printf("Leaves: %ld, internal nodes: %ld\n", tree->leaf_count, tree->internal_count);
+    printf("Node memory: %ld bytes (%.1f per key)\n", bytes,
+           tree->size ? (double)bytes / tree->size : 0.0);
+    if (bpt_min(tree, &min_key) && bpt_max(tree, &max_key)) {
+        printf("Minimum Value: %d\n", min_key);
+        printf("Maximum Value: %d\n", max_key);
+    }
+}
+
+// Uniform index below n from two rand() calls, since RAND_MAX may be
+// as small as 32767
+long random_index(long n) {
+    return (long)(((unsigned long)rand() << 15 ^ (unsigned long)rand()) % (unsigned long)n);
+}
+
+// Loads the same distinct pseudo-random keys into the B+-tree and an AVL
+// BST at each size from 1M up to max_keys (x10 steps), then times random
+// lookups, range counts and deleting half of the keys.
+void benchmark_bpt_vs_bst(int max_keys) {
+    bool saved_mode = avl_balancing;
+    avl_balancing = true;
+    
+    printf("\n=== B+-Tree vs AVL BST (%d lookups, %d ranges of width %d) ===\n",
+           BPT_BENCH_LOOKUPS, BPT_BENCH_RANGES, BPT_BENCH_RANGE_WIDTH);
+    printf("%-10s %-6s %-11s %-11s %-11s %-11s %-7s %-11s %s\n", "Keys", "Index", "Insert (s)",
+           "Lookup (s)", "Range (s)", "Delete (s)", "Height", "Bytes/key", "Valid");
+    
+    for (long n = 1000000; n <= max_keys; n *= 10) {
+        int* keys = (int*)malloc(n * sizeof(int));
+        int* probes = (int*)malloc(BPT_BENCH_LOOKUPS * sizeof(int));
+        if (!keys || !probes) {
+            printf("Memory allocation failed!\n");
+            free(keys);
+            free(probes);
+            break;
+        }
+        
+        // Multiplying by an odd constant is a bijection on 32-bit values,
+        // so the keys are distinct and spread over the whole int range. They
+        // are shuffled because consecutive multiples arrive in an order that
+        // keeps the BST's recent insert paths cache-hot.
+        for (long i = 0; i < n; i++) {
+            keys[i] = (int)((uint32_t)i * 2654435761u);
+        }
+        for (long i = n - 1; i > 0; i--) {
+            long j = random_index(i + 1);
+            int temp = keys[i];
+            keys[i] = keys[j];
+            keys[j] = temp;
+        }
+        for (int i = 0; i < BPT_BENCH_LOOKUPS; i++) {
+            probes[i] = keys[random_index(n)];
+        }
+        
+        for (int index = 0; index < 2; index++) {
+            BPlusTree* tree = index == 0 ? bpt_create() : NULL;
+            BSTNode* root = NULL;
+            NodePool bst_pool = NODE_POOL_INITIALIZER(BSTNode);
+            bool ok = index == 1 || tree;
+            
+            clock_t start = clock();
+            for (long i = 0; ok && i < n; i++) {
+                if (index == 0) {
+                    ok = bpt_insert(tree, keys[i]);
+                } else {
+                    root = insert_iterative(&bst_pool, root, keys[i]);
+                }
+            }
+            double insert_time = ((double)(clock() - start)) / CLOCKS_PER_SEC;
+            
+            long found = 0;
+            start = clock();
+            for (int i = 0; ok && i < BPT_BENCH_LOOKUPS; i++) {
+                found += index == 0 ? bpt_search(tree, probes[i])
+                                    : search_iterative(root, probes[i]) != NULL;
+            }
+            double lookup_time = ((double)(clock() - start)) / CLOCKS_PER_SEC;
+            
+            // Keys are spread evenly, so each range holds about
+            // n * width / 2^32 of them
+            long in_ranges = 0;
+            start = clock();
+            for (int i = 0; ok && i < BPT_BENCH_RANGES; i++) {
+                int low = probes[i];
+                int high = low > INT_MAX - BPT_BENCH_RANGE_WIDTH
+                               ? INT_MAX : low + BPT_BENCH_RANGE_WIDTH;
+                in_ranges += index == 0 ? bpt_range_count(tree, low, high)
+                                        : count_range(root, low, high);
+            }
+            double range_time = ((double)(clock() - start)) / CLOCKS_PER_SEC;
+            
+            int height = index == 0 ? tree->height : node_height(root);
+            double bytes_per_key = index == 0
+                ? (double)(tree->leaf_count + tree->internal_count) * BPT_NODE_SIZE / n
+                : (double)sizeof(BSTNode);
+            bool valid = ok && found == BPT_BENCH_LOOKUPS &&
+                         (index == 0 ? bpt_is_valid(tree) : is_valid_bst(root));
+            
+            start = clock();
+            for (long i = 0; ok && i < n; i += 2) {
+                if (index == 0) {
+                    ok = bpt_delete(tree, keys[i]);
+                } else {
+                    root = delete_node(&bst_pool, root, keys[i]);
+                }
+            }
+            double delete_time = ((double)(clock() - start)) / CLOCKS_PER_SEC;
+            valid = valid && ok && (index == 0 ? tree->size == n / 2 && bpt_is_valid(tree)
+                                               : tree_size(root) == n / 2);
+            
+            printf("%-10ld %-6s %-11.4f %-11.4f %-11.4f %-11.4f %-7d %-11.1f %s (%ld in ranges)\n",
+                   n, index == 0 ? "B+" : "AVL", insert_time, lookup_time, range_time,
+                   delete_time, height, bytes_per_key, valid ? "Yes" : "No", in_ranges);
+            
+            if (index == 0) {
+                bpt_free(tree);
+            } else {
+                free_tree(&bst_pool, root);
+            }
+        }
+        
+        free(keys);
+        free(probes);
+    }
+    
+    avl_balancing = saved_mode;
+}
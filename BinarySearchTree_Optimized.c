@@ -1,14 +1,23 @@
+#include "PerfCounters.h"
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
 #include <limits.h>
+#include <time.h>
+
+#include "MemoryPool.h"
+
+#define AVL_MAX_HEIGHT 64           // An AVL tree of INT_MAX nodes is under 46 high
+#define PLAIN_BST_BENCH_LIMIT 20000 // Ascending inserts into a plain BST are O(n^2)
 
 // BST Node structure
 typedef struct BSTNode {
     int data;
     struct BSTNode* left;
     struct BSTNode* right;
-    int height;  // For potential AVL balancing
+    int height;  // Subtree height, maintained while avl_balancing is on
+    int size;    // Nodes in this subtree, including this one
 } BSTNode;
 
 // Stack for iterative operations
@@ -32,16 +41,64 @@ typedef struct Queue {
     QueueNode* rear;
 } Queue;
 
+// In-order cursor over the keys in [low, high]. The stack holds the nodes
+// whose key and right subtree are still to be visited, smallest on top.
+typedef struct RangeIterator {
+    BSTNode** stack;
+    int top;
+    int capacity;
+    int low;
+    int high;
+} RangeIterator;
+
+// With avl_balancing on, insert and delete keep every node's subtrees
+// within one level of each other, so the height stays below
+// 1.44 log2(n + 2) even for sorted input. It can only change while the
+// tree is empty, since a plain tree's heights are not maintained.
+bool avl_balancing = true;
+
 // Function prototypes
-BSTNode* create_node(int data);
-BSTNode* insert_recursive(BSTNode* root, int data);
-BSTNode* insert_iterative(BSTNode* root, int data);
-BSTNode* delete_node(BSTNode* root, int data);
+// Each tree owns a NodePool (see MemoryPool.h), which every function that
+// allocates or frees nodes takes first; with -DUSE_NODE_POOL the nodes are
+// carved from the pool's blocks instead of malloc'd
+BSTNode* create_node(NodePool* pool, int data);
+BSTNode* insert_recursive(NodePool* pool, BSTNode* root, int data);
+BSTNode* insert_iterative(NodePool* pool, BSTNode* root, int data);
+BSTNode* delete_node(NodePool* pool, BSTNode* root, int data);
 BSTNode* find_min(BSTNode* root);
 BSTNode* find_max(BSTNode* root);
 BSTNode* search_recursive(BSTNode* root, int data);
 BSTNode* search_iterative(BSTNode* root, int data);
 
+// AVL balancing
+int node_height(BSTNode* node);
+void update_height(BSTNode* node);
+void update_size(BSTNode* node);
+BSTNode* rotate_left(BSTNode* node);
+BSTNode* rotate_right(BSTNode* node);
+BSTNode* avl_rebalance(BSTNode* node);
+void benchmark_ascending_inserts(int n);
+void benchmark_node_pool(int n);
+
+// Order statistics and range queries, O(log n) using subtree sizes
+BSTNode* bst_select(BSTNode* root, int k);
+int bst_rank(BSTNode* root, int data);
+int bst_count_at_most(BSTNode* root, int data);
+int count_range(BSTNode* root, int low, int high);
+bool range_iterator_init(RangeIterator* it, BSTNode* root, int low, int high);
+bool range_iterator_push_left(RangeIterator* it, BSTNode* node);
+bool range_iterator_next(RangeIterator* it, int* data);
+void range_iterator_free(RangeIterator* it);
+int range_scan(BSTNode* root, int low, int high, int out[], int max_out);
+
+// Bulk loading and rebalancing, O(n)
+BSTNode* build_from_sorted(NodePool* pool, const int arr[], int n);
+BSTNode* build_balanced(NodePool* pool, const int arr[], int n);
+BSTNode* rebalance(BSTNode* root);
+BSTNode* tree_to_vine(BSTNode* root);
+BSTNode* vine_to_tree(BSTNode** vine, int n);
+void benchmark_bulk_load(int n);
+
 // Traversal functions
 void inorder_recursive(BSTNode* root);
 void preorder_recursive(BSTNode* root);
@@ -60,7 +117,8 @@ int count_leaves(BSTNode* root);
 void print_tree_structure(BSTNode* root, int level);
 
 // Utility functions
-void free_tree(BSTNode* root);
+void free_tree(NodePool* pool, BSTNode* root);
+void free_nodes(NodePool* pool, BSTNode* root);
 BSTNode* copy_tree(BSTNode* root);
 void print_tree_info(BSTNode* root);
 
@@ -78,9 +136,11 @@ BSTNode* dequeue(Queue* queue);
 bool is_queue_empty(Queue* queue);
 void free_queue(Queue* queue);
 
+#ifndef BST_NO_MAIN
 int main() {
     BSTNode* root = NULL;
-    int choice, value;
+    NodePool node_pool = NODE_POOL_INITIALIZER(BSTNode);
+    int choice, value, high;
     BSTNode* result;
     
     printf("=== Optimized Binary Search Tree ===\n");
@@ -103,7 +163,17 @@ int main() {
         printf("14. Tree Statistics\n");
         printf("15. Validate BST\n");
         printf("16. Clear Tree\n");
-        printf("17. Exit\n");
+        printf("17. Toggle AVL Balancing (currently %s)\n", avl_balancing ? "on" : "off");
+        printf("18. Ascending Insert Benchmark\n");
+        printf("19. Node Allocator Benchmark\n");
+        printf("20. Select k-th Smallest\n");
+        printf("21. Rank of Value\n");
+        printf("22. Count Keys in Range\n");
+        printf("23. Range Scan\n");
+        printf("24. Bulk Load Sorted Keys\n");
+        printf("25. Rebalance Tree\n");
+        printf("26. Bulk Load Benchmark\n");
+        printf("27. Exit\n");
         printf("Enter your choice: ");
         
         if (scanf("%d", &choice) != 1) {
@@ -116,7 +186,7 @@ int main() {
             case 1:
                 printf("Enter value to insert: ");
                 if (scanf("%d", &value) == 1) {
-                    root = insert_recursive(root, value);
+                    root = insert_recursive(&node_pool, root, value);
                     printf("Value %d inserted successfully (recursive).\n", value);
                 } else {
                     printf("Invalid input!\n");
@@ -127,7 +197,7 @@ int main() {
             case 2:
                 printf("Enter value to insert: ");
                 if (scanf("%d", &value) == 1) {
-                    root = insert_iterative(root, value);
+                    root = insert_iterative(&node_pool, root, value);
                     printf("Value %d inserted successfully (iterative).\n", value);
                 } else {
                     printf("Invalid input!\n");
@@ -142,7 +212,7 @@ int main() {
                 }
                 printf("Enter value to delete: ");
                 if (scanf("%d", &value) == 1) {
-                    root = delete_node(root, value);
+                    root = delete_node(&node_pool, root, value);
                     printf("Value %d deleted successfully.\n", value);
                 } else {
                     printf("Invalid input!\n");
@@ -173,7 +243,7 @@ int main() {
                 }
                 printf("Enter value to search: ");
                 if (scanf("%d", &value) == 1) {
-                    result = search_iterative(root, value);
+                    PERF_MEASURE("search_iterative", 1, result = search_iterative(root, value));
                     printf("Value %d %s in the tree (iterative search).\n", 
                            value, result ? "found" : "not found");
                 } else {
@@ -280,7 +350,7 @@ int main() {
                 
             case 16:
                 if (root) {
-                    free_tree(root);
+                    free_tree(&node_pool, root);
                     root = NULL;
                     printf("Tree cleared successfully.\n");
                 } else {
@@ -290,7 +360,144 @@ int main() {
                 
             case 17:
                 if (root) {
-                    free_tree(root);
+                    printf("Clear the tree before changing the balancing mode.\n");
+                    break;
+                }
+                avl_balancing = !avl_balancing;
+                printf("AVL balancing %s.\n", avl_balancing ? "enabled" : "disabled");
+                break;
+                
+            case 18:
+                printf("Enter number of ascending keys (1000 to 10000000): ");
+                if (scanf("%d", &value) == 1 && value >= 1000 && value <= 10000000) {
+                    benchmark_ascending_inserts(value);
+                } else {
+                    printf("Invalid size!\n");
+                    while (getchar() != '\n');
+                }
+                break;
+                
+            case 19:
+                printf("Enter number of keys (1000 to 10000000): ");
+                if (scanf("%d", &value) == 1 && value >= 1000 && value <= 10000000) {
+                    benchmark_node_pool(value);
+                } else {
+                    printf("Invalid size!\n");
+                    while (getchar() != '\n');
+                }
+                break;
+                
+            case 20:
+                if (!root) {
+                    printf("Tree is empty!\n");
+                    break;
+                }
+                printf("Enter k (1-%d): ", tree_size(root));
+                if (scanf("%d", &value) == 1) {
+                    result = bst_select(root, value);
+                    if (result) {
+                        printf("Key %d in sorted order is %d.\n", value, result->data);
+                    } else {
+                        printf("k must be between 1 and %d.\n", tree_size(root));
+                    }
+                } else {
+                    printf("Invalid input!\n");
+                    while (getchar() != '\n');
+                }
+                break;
+                
+            case 21:
+                printf("Enter value: ");
+                if (scanf("%d", &value) == 1) {
+                    printf("%d keys are smaller than %d.\n", bst_rank(root, value), value);
+                } else {
+                    printf("Invalid input!\n");
+                    while (getchar() != '\n');
+                }
+                break;
+                
+            case 22:
+                printf("Enter low and high bounds: ");
+                if (scanf("%d %d", &value, &high) == 2 && value <= high) {
+                    printf("%d keys in [%d, %d].\n", count_range(root, value, high), value, high);
+                } else {
+                    printf("Invalid range!\n");
+                    while (getchar() != '\n');
+                }
+                break;
+                
+            case 23: {
+                printf("Enter low and high bounds: ");
+                if (scanf("%d %d", &value, &high) != 2 || value > high) {
+                    printf("Invalid range!\n");
+                    while (getchar() != '\n');
+                    break;
+                }
+                
+                int shown[20];
+                int total = count_range(root, value, high);
+                int count = range_scan(root, value, high, shown, 20);
+                printf("%d keys in [%d, %d]:", total, value, high);
+                for (int i = 0; i < count; i++) {
+                    printf(" %d", shown[i]);
+                }
+                printf("%s\n", total > count ? " ..." : "");
+                break;
+            }
+                
+            case 24: {
+                if (root) {
+                    printf("Clear the tree before bulk loading.\n");
+                    break;
+                }
+                int count;
+                printf("Enter number of keys, first key and step: ");
+                if (scanf("%d %d %d", &count, &value, &high) != 3 || count < 1 || high < 1 ||
+                    (long long)value + (long long)(count - 1) * high > INT_MAX) {
+                    printf("Invalid input!\n");
+                    while (getchar() != '\n');
+                    break;
+                }
+                
+                int* keys = (int*)malloc(count * sizeof(int));
+                if (!keys) {
+                    printf("Memory allocation failed!\n");
+                    break;
+                }
+                for (int i = 0; i < count; i++) {
+                    keys[i] = (int)(value + (long long)i * high);
+                }
+                root = build_from_sorted(&node_pool, keys, count);
+                free(keys);
+                if (root) {
+                    printf("Loaded %d keys, height %d.\n", tree_size(root), node_height(root));
+                }
+                break;
+            }
+                
+            case 25:
+                if (!root) {
+                    printf("Tree is empty!\n");
+                    break;
+                }
+                value = tree_height(root);
+                root = rebalance(root);
+                printf("Tree rebalanced: height %d -> %d.\n", value, node_height(root));
+                break;
+                
+            case 26:
+                printf("Enter number of keys (1000 to 10000000): ");
+                if (scanf("%d", &value) == 1 && value >= 1000 && value <= 10000000) {
+                    benchmark_bulk_load(value);
+                } else {
+                    printf("Invalid size!\n");
+                    while (getchar() != '\n');
+                }
+                break;
+                
+            case 27:
+                if (root) {
+                    free_tree(&node_pool, root);
                 }
                 printf("Exiting program...\n");
                 return 0;
@@ -302,9 +509,10 @@ int main() {
     
     return 0;
 }
+#endif
 
-BSTNode* create_node(int data) {
-    BSTNode* new_node = (BSTNode*)malloc(sizeof(BSTNode));
+BSTNode* create_node(NodePool* pool, int data) {
+    BSTNode* new_node = (BSTNode*)pool_alloc(pool);
     if (!new_node) {
         printf("Memory allocation failed!\n");
         return NULL;
@@ -314,33 +522,70 @@ BSTNode* create_node(int data) {
     new_node->left = NULL;
     new_node->right = NULL;
     new_node->height = 1;
+    new_node->size = 1;
     
     return new_node;
 }
 
-BSTNode* insert_recursive(BSTNode* root, int data) {
+BSTNode* insert_recursive(NodePool* pool, BSTNode* root, int data) {
     if (root == NULL) {
-        return create_node(data);
+        return create_node(pool, data);
     }
     
     if (data < root->data) {
-        root->left = insert_recursive(root->left, data);
+        root->left = insert_recursive(pool, root->left, data);
     } else if (data > root->data) {
-        root->right = insert_recursive(root->right, data);
+        root->right = insert_recursive(pool, root->right, data);
     }
     // If data equals root->data, we don't insert (no duplicates)
     
+    if (avl_balancing) return avl_rebalance(root);
+    update_size(root);
     return root;
 }
 
-BSTNode* insert_iterative(BSTNode* root, int data) {
-    BSTNode* new_node = create_node(data);
+BSTNode* insert_iterative(NodePool* pool, BSTNode* root, int data) {
+    BSTNode* new_node = create_node(pool, data);
     if (!new_node) return root;
     
     if (root == NULL) {
         return new_node;
     }
     
+    if (avl_balancing) {
+        // Record the link to every node on the path so rotations can
+        // re-point the parent, then rebalance bottom-up until a subtree's
+        // height stops changing
+        BSTNode** path[AVL_MAX_HEIGHT];
+        BSTNode** link = &root;
+        int depth = 0;
+        
+        while (*link != NULL) {
+            if (data == (*link)->data) {
+                pool_free(pool, new_node);
+                return root;
+            }
+            path[depth++] = link;
+            link = data < (*link)->data ? &(*link)->left : &(*link)->right;
+        }
+        *link = new_node;
+        
+        // Every ancestor gains one node; rotations recompute sizes from
+        // their children, so the counts stay right even past the early stop
+        for (int i = 0; i < depth; i++) {
+            (*path[i])->size++;
+        }
+        
+        while (depth > 0) {
+            BSTNode** node_link = path[--depth];
+            int old_height = (*node_link)->height;
+            *node_link = avl_rebalance(*node_link);
+            if ((*node_link)->height == old_height) break;
+        }
+        
+        return root;
+    }
+    
     BSTNode* current = root;
     BSTNode* parent = NULL;
     
@@ -352,7 +597,7 @@ BSTNode* insert_iterative(BSTNode* root, int data) {
             current = current->right;
         } else {
             // Duplicate found, don't insert
-            free(new_node);
+            pool_free(pool, new_node);
             return root;
         }
     }
@@ -363,48 +608,118 @@ BSTNode* insert_iterative(BSTNode* root, int data) {
         parent->right = new_node;
     }
     
+    // The key was new, so every node on its path gains one descendant
+    for (current = root; current != new_node;
+         current = data < current->data ? current->left : current->right) {
+        current->size++;
+    }
+    
     return root;
 }
 
-BSTNode* delete_node(BSTNode* root, int data) {
+BSTNode* delete_node(NodePool* pool, BSTNode* root, int data) {
     if (root == NULL) {
         return root;
     }
     
     if (data < root->data) {
-        root->left = delete_node(root->left, data);
+        root->left = delete_node(pool, root->left, data);
     } else if (data > root->data) {
-        root->right = delete_node(root->right, data);
+        root->right = delete_node(pool, root->right, data);
     } else {
         // Node to be deleted found
         
         // Case 1: Node with no children (leaf)
         if (root->left == NULL && root->right == NULL) {
-            free(root);
+            pool_free(pool, root);
             return NULL;
         }
         
         // Case 2: Node with one child
         if (root->left == NULL) {
             BSTNode* temp = root->right;
-            free(root);
+            pool_free(pool, root);
             return temp;
         }
         if (root->right == NULL) {
             BSTNode* temp = root->left;
-            free(root);
+            pool_free(pool, root);
             return temp;
         }
         
         // Case 3: Node with two children
         BSTNode* temp = find_min(root->right);
         root->data = temp->data;
-        root->right = delete_node(root->right, temp->data);
+        root->right = delete_node(pool, root->right, temp->data);
     }
     
+    if (avl_balancing) return avl_rebalance(root);
+    update_size(root);
     return root;
 }
 
+int node_height(BSTNode* node) {
+    return node ? node->height : 0;
+}
+
+void update_height(BSTNode* node) {
+    int left_height = node_height(node->left);
+    int right_height = node_height(node->right);
+    node->height = 1 + (left_height > right_height ? left_height : right_height);
+}
+
+void update_size(BSTNode* node) {
+    node->size = 1 + tree_size(node->left) + tree_size(node->right);
+}
+
+// Lifts node->right into node's place and returns the new subtree root
+BSTNode* rotate_left(BSTNode* node) {
+    BSTNode* pivot = node->right;
+    node->right = pivot->left;
+    pivot->left = node;
+    update_height(node);
+    update_height(pivot);
+    update_size(node);
+    update_size(pivot);
+    return pivot;
+}
+
+// Lifts node->left into node's place and returns the new subtree root
+BSTNode* rotate_right(BSTNode* node) {
+    BSTNode* pivot = node->left;
+    node->left = pivot->right;
+    pivot->right = node;
+    update_height(node);
+    update_height(pivot);
+    update_size(node);
+    update_size(pivot);
+    return pivot;
+}
+
+// Refreshes node's height and size and restores the AVL property with a
+// single or double rotation. Both subtrees must already be balanced.
+BSTNode* avl_rebalance(BSTNode* node) {
+    update_height(node);
+    update_size(node);
+    int balance = node_height(node->left) - node_height(node->right);
+    
+    if (balance > 1) {
+        if (node_height(node->left->left) < node_height(node->left->right)) {
+            node->left = rotate_left(node->left);
+        }
+        return rotate_right(node);
+    }
+    
+    if (balance < -1) {
+        if (node_height(node->right->right) < node_height(node->right->left)) {
+            node->right = rotate_right(node->right);
+        }
+        return rotate_left(node);
+    }
+    
+    return node;
+}
+
 BSTNode* find_min(BSTNode* root) {
     if (root == NULL) return NULL;
     
@@ -448,6 +763,254 @@ BSTNode* search_iterative(BSTNode* root, int data) {
     return NULL;
 }
 
+// Returns the k-th smallest node (k counts from 1), or NULL if k is out of range
+BSTNode* bst_select(BSTNode* root, int k) {
+    if (k < 1 || k > tree_size(root)) return NULL;
+    
+    while (root != NULL) {
+        int left_size = tree_size(root->left);
+        if (k <= left_size) {
+            root = root->left;
+        } else if (k == left_size + 1) {
+            return root;
+        } else {
+            k -= left_size + 1;
+            root = root->right;
+        }
+    }
+    
+    return NULL;
+}
+
+// Number of keys smaller than data, which is data's 0-based position if present
+int bst_rank(BSTNode* root, int data) {
+    int rank = 0;
+    
+    while (root != NULL) {
+        if (data <= root->data) {
+            root = root->left;
+        } else {
+            rank += 1 + tree_size(root->left);
+            root = root->right;
+        }
+    }
+    
+    return rank;
+}
+
+int bst_count_at_most(BSTNode* root, int data) {
+    int count = 0;
+    
+    while (root != NULL) {
+        if (data < root->data) {
+            root = root->left;
+        } else {
+            count += 1 + tree_size(root->left);
+            root = root->right;
+        }
+    }
+    
+    return count;
+}
+
+int count_range(BSTNode* root, int low, int high) {
+    if (low > high) return 0;
+    return bst_count_at_most(root, high) - bst_rank(root, low);
+}
+
+// Positions the iterator before the smallest key >= low. Only the search
+// path for low is pushed, so starting a scan costs O(height).
+bool range_iterator_init(RangeIterator* it, BSTNode* root, int low, int high) {
+    it->capacity = AVL_MAX_HEIGHT;
+    it->stack = (BSTNode**)malloc(it->capacity * sizeof(BSTNode*));
+    it->top = -1;
+    it->low = low;
+    it->high = high;
+    if (!it->stack) return false;
+    
+    return range_iterator_push_left(it, root);
+}
+
+// Pushes node and its left spine, skipping subtrees whose keys are all < low
+bool range_iterator_push_left(RangeIterator* it, BSTNode* node) {
+    while (node != NULL) {
+        if (node->data < it->low) {
+            node = node->right;
+            continue;
+        }
+        
+        // A plain (unbalanced) tree can be deeper than AVL_MAX_HEIGHT
+        if (it->top + 1 == it->capacity) {
+            BSTNode** grown = (BSTNode**)realloc(it->stack, 2 * it->capacity * sizeof(BSTNode*));
+            if (!grown) {
+                printf("Memory allocation failed!\n");
+                return false;
+            }
+            it->stack = grown;
+            it->capacity *= 2;
+        }
+        
+        it->stack[++it->top] = node;
+        node = node->left;
+    }
+    
+    return true;
+}
+
+// Stores the next key in range and returns true, or returns false once the
+// range is exhausted
+bool range_iterator_next(RangeIterator* it, int* data) {
+    if (it->top < 0) return false;
+    
+    BSTNode* node = it->stack[it->top--];
+    if (node->data > it->high) {
+        it->top = -1;
+        return false;
+    }
+    
+    *data = node->data;
+    if (!range_iterator_push_left(it, node->right)) {
+        it->top = -1;
+    }
+    return true;
+}
+
+void range_iterator_free(RangeIterator* it) {
+    free(it->stack);
+    it->stack = NULL;
+    it->top = -1;
+}
+
+// Copies up to max_out keys in [low, high] to out in ascending order and
+// returns how many were copied, visiting O(height + max_out) nodes
+int range_scan(BSTNode* root, int low, int high, int out[], int max_out) {
+    RangeIterator it;
+    int count = 0;
+    
+    if (!range_iterator_init(&it, root, low, high)) {
+        range_iterator_free(&it);
+        return 0;
+    }
+    
+    while (count < max_out && range_iterator_next(&it, &out[count])) {
+        count++;
+    }
+    
+    range_iterator_free(&it);
+    return count;
+}
+
+// Builds a perfectly balanced tree from keys in ascending order in O(n).
+// Repeated keys are loaded once; returns NULL if arr is not sorted or
+// memory runs out. With a node pool the nodes are allocated back to back.
+BSTNode* build_from_sorted(NodePool* pool, const int arr[], int n) {
+    int duplicates = 0;
+    
+    for (int i = 1; i < n; i++) {
+        if (arr[i] < arr[i - 1]) {
+            printf("Keys are not sorted!\n");
+            return NULL;
+        }
+        duplicates += arr[i] == arr[i - 1];
+    }
+    
+    if (duplicates == 0) {
+        BSTNode* root = build_balanced(pool, arr, n);
+        if (tree_size(root) == n) return root;
+        free_nodes(pool, root);
+        return NULL;
+    }
+    
+    int* unique = (int*)malloc((n - duplicates) * sizeof(int));
+    if (!unique) {
+        printf("Memory allocation failed!\n");
+        return NULL;
+    }
+    
+    int count = 0;
+    for (int i = 0; i < n; i++) {
+        if (i == 0 || arr[i] != arr[i - 1]) unique[count++] = arr[i];
+    }
+    
+    BSTNode* root = build_balanced(pool, unique, count);
+    if (tree_size(root) != count) {
+        free_nodes(pool, root);
+        root = NULL;
+    }
+    free(unique);
+    return root;
+}
+
+// Makes the middle key the root and recurses on each half, allocating in
+// preorder so a descent walks forward through memory. A failed allocation
+// leaves its subtree out, which the caller detects from the size.
+BSTNode* build_balanced(NodePool* pool, const int arr[], int n) {
+    if (n <= 0) return NULL;
+    
+    int mid = n / 2;
+    BSTNode* root = create_node(pool, arr[mid]);
+    if (!root) return NULL;
+    
+    root->left = build_balanced(pool, arr, mid);
+    root->right = build_balanced(pool, arr + mid + 1, n - mid - 1);
+    update_height(root);
+    update_size(root);
+    
+    return root;
+}
+
+// Relinks the existing nodes into a perfectly balanced tree in O(n) time
+// without allocating: the tree is straightened into a sorted right-leaning
+// chain (a vine) and the vine is then folded back up. Works on plain trees
+// of any depth, and leaves heights valid for AVL balancing.
+BSTNode* rebalance(BSTNode* root) {
+    int n = tree_size(root);
+    BSTNode* vine = tree_to_vine(root);
+    return vine_to_tree(&vine, n);
+}
+
+// Rotates left children up until no node has one, returning the first
+// node of the resulting chain linked through right pointers
+BSTNode* tree_to_vine(BSTNode* root) {
+    BSTNode head;
+    BSTNode* tail = &head;
+    BSTNode* rest = root;
+    
+    head.right = root;
+    while (rest != NULL) {
+        if (rest->left == NULL) {
+            tail = rest;
+            rest = rest->right;
+        } else {
+            BSTNode* child = rest->left;
+            rest->left = child->right;
+            child->right = rest;
+            rest = child;
+            tail->right = child;
+        }
+    }
+    
+    return head.right;
+}
+
+// Consumes the first n nodes of the vine in order, building the same
+// shape as build_balanced, and advances *vine past them
+BSTNode* vine_to_tree(BSTNode** vine, int n) {
+    if (n <= 0) return NULL;
+    
+    int mid = n / 2;
+    BSTNode* left = vine_to_tree(vine, mid);
+    BSTNode* root = *vine;
+    *vine = root->right;
+    
+    root->left = left;
+    root->right = vine_to_tree(vine, n - mid - 1);
+    update_height(root);
+    update_size(root);
+    
+    return root;
+}
+
 void inorder_recursive(BSTNode* root) {
     if (root != NULL) {
         inorder_recursive(root->left);
@@ -571,9 +1134,7 @@ int tree_height(BSTNode* root) {
 }
 
 int tree_size(BSTNode* root) {
-    if (root == NULL) return 0;
-    
-    return 1 + tree_size(root->left) + tree_size(root->right);
+    return root ? root->size : 0;
 }
 
 bool is_valid_bst(BSTNode* root) {
@@ -617,6 +1178,7 @@ void print_tree_structure(BSTNode* root, int level) {
 void print_tree_info(BSTNode* root) {
     printf("\n=== Tree Statistics ===\n");
     printf("Tree Height: %d\n", tree_height(root));
+    printf("AVL Balancing: %s\n", avl_balancing ? "On" : "Off");
     printf("Tree Size: %d\n", tree_size(root));
     printf("Number of Leaves: %d\n", count_leaves(root));
     printf("Is Valid BST: %s\n", is_valid_bst(root) ? "Yes" : "No");
@@ -627,11 +1189,22 @@ void print_tree_info(BSTNode* root) {
     printf("Maximum Value: %d\n", max_node ? max_node->data : 0);
 }
 
-void free_tree(BSTNode* root) {
+// Releases a tree along with its pool, which must hold no other tree.
+// Pooled nodes go with the pool's blocks, so only malloc'd nodes are
+// visited one by one.
+void free_tree(NodePool* pool, BSTNode* root) {
+    if (!pool_owns_nodes(pool)) {
+        free_nodes(pool, root);
+    }
+    pool_destroy(pool);
+}
+
+// Returns every node of a subtree to its pool individually
+void free_nodes(NodePool* pool, BSTNode* root) {
     if (root != NULL) {
-        free_tree(root->left);
-        free_tree(root->right);
-        free(root);
+        free_nodes(pool, root->left);
+        free_nodes(pool, root->right);
+        pool_free(pool, root);
     }
 }
 
@@ -724,4 +1297,187 @@ void free_queue(Queue* queue) {
         dequeue(queue);
     }
     free(queue);
-}
\ No newline at end of file
+}
+
+// Inserts keys 1..n in ascending order, the worst case for a plain BST,
+// and reports time, height and search time with and without balancing.
+// The plain tree is limited to PLAIN_BST_BENCH_LIMIT keys.
+void benchmark_ascending_inserts(int n) {
+    bool saved_mode = avl_balancing;
+    int plain_n = n < PLAIN_BST_BENCH_LIMIT ? n : PLAIN_BST_BENCH_LIMIT;
+    
+    // 1.44 log2(n + 2) bounds the height of any AVL tree; log2_n + 1 is
+    // log2(n + 2) rounded up
+    int log2_n = 0;
+    while (log2_n < 31 && (1L << (log2_n + 1)) <= (long)n + 2) log2_n++;
+    
+    printf("\n=== Ascending Insert Benchmark ===\n");
+    printf("%-6s %-10s %-12s %-8s %-12s %s\n", "Mode", "Keys", "Insert (s)", "Height",
+           "Search (s)", "Valid");
+    
+    for (int run = 0; run < 3; run++) {
+        int keys = run == 2 ? n : plain_n;
+        if (run == 2 && n == plain_n) break;
+        avl_balancing = run != 0;
+        
+        BSTNode* root = NULL;
+        NodePool pool = NODE_POOL_INITIALIZER(BSTNode);
+        clock_t start = clock();
+        for (int key = 1; key <= keys; key++) {
+            root = insert_iterative(&pool, root, key);
+        }
+        double insert_time = ((double)(clock() - start)) / CLOCKS_PER_SEC;
+        
+        int found = 0;
+        start = clock();
+        for (int key = 1; key <= keys; key++) {
+            found += search_iterative(root, key) != NULL;
+        }
+        double search_time = ((double)(clock() - start)) / CLOCKS_PER_SEC;
+        
+        int height = avl_balancing ? node_height(root) : tree_height(root);
+        printf("%-6s %-10d %-12.4f %-8d %-12.4f %s\n", avl_balancing ? "AVL" : "Plain", keys,
+               insert_time, height, search_time,
+               found == keys && is_valid_bst(root) ? "Yes" : "No");
+        free_tree(&pool, root);
+    }
+    
+    printf("AVL height bound for %d keys: %d\n", n, (int)(1.44 * (log2_n + 1)));
+    
+    avl_balancing = saved_mode;
+}
+
+// Builds a tree of n random keys, then deletes and reinserts n random keys,
+// searches every key and tears the tree down, once with a node per malloc
+// and once from the tree's own node pool
+void benchmark_node_pool(int n) {
+    int* keys = (int*)malloc(n * sizeof(int));
+    if (!keys) {
+        printf("Memory allocation failed!\n");
+        return;
+    }
+    
+    double totals[2];
+    size_t malloc_calls[2];
+    
+    printf("\n=== Node Allocator Benchmark (%d keys) ===\n", n);
+    printf("%-7s %-10s %-10s %-10s %-10s %-10s %-9s %s\n", "Nodes", "Build (s)", "Churn (s)",
+           "Search (s)", "Free (s)", "Total (s)", "Found", "malloc calls");
+    
+    for (int run = 0; run < 2; run++) {
+        NodePool pool;
+        pool_init(&pool, sizeof(BSTNode));
+        pool.use_malloc = run == 0;
+        srand(42);
+        
+        BSTNode* root = NULL;
+        clock_t start = clock();
+        for (int i = 0; i < n; i++) {
+            keys[i] = rand();
+            root = insert_iterative(&pool, root, keys[i]);
+        }
+        double build_time = ((double)(clock() - start)) / CLOCKS_PER_SEC;
+        
+        start = clock();
+        for (int i = 0; i < n; i++) {
+            int slot = rand() % n;
+            root = delete_node(&pool, root, keys[slot]);
+            keys[slot] = rand();
+            root = insert_iterative(&pool, root, keys[slot]);
+        }
+        double churn_time = ((double)(clock() - start)) / CLOCKS_PER_SEC;
+        
+        int found = 0;
+        start = clock();
+        for (int i = 0; i < n; i++) {
+            found += search_iterative(root, keys[i]) != NULL;
+        }
+        double search_time = ((double)(clock() - start)) / CLOCKS_PER_SEC;
+        
+        // A pooled tree is freed block by block, a malloc'd one node by node
+        start = clock();
+        free_tree(&pool, root);
+        double free_time = ((double)(clock() - start)) / CLOCKS_PER_SEC;
+        
+        totals[run] = build_time + churn_time + search_time + free_time;
+        malloc_calls[run] = pool.malloc_calls;
+        printf("%-7s %-10.4f %-10.4f %-10.4f %-10.4f %-10.4f %-9d %zu\n", run == 0 ? "malloc" : "pool",
+               build_time, churn_time, search_time, free_time, totals[run], found,
+               malloc_calls[run]);
+        pool_print_stats(&pool, "  allocator");
+    }
+    
+    printf("Pool saves %.4f s (%.1f%%) and %zu malloc calls\n", totals[0] - totals[1],
+           totals[0] > 0 ? 100.0 * (totals[0] - totals[1]) / totals[0] : 0.0,
+           malloc_calls[0] - malloc_calls[1]);
+    
+    free(keys);
+}
+
+// Loads n ascending keys by repeated AVL insertion and by build_from_sorted,
+// rebalances a degenerate plain tree (up to PLAIN_BST_BENCH_LIMIT keys) and
+// the insert-built AVL tree, and reports time and resulting height.
+void benchmark_bulk_load(int n) {
+    int* keys = (int*)malloc(n * sizeof(int));
+    if (!keys) {
+        printf("Memory allocation failed!\n");
+        return;
+    }
+    
+    for (int i = 0; i < n; i++) {
+        keys[i] = 2 * i;
+    }
+    
+    bool saved_mode = avl_balancing;
+    int plain_n = n < PLAIN_BST_BENCH_LIMIT ? n : PLAIN_BST_BENCH_LIMIT;
+    int min_height = 0;
+    while (min_height < 31 && (1L << min_height) <= (long)n) min_height++;
+    
+    printf("\n=== Bulk Load Benchmark ===\n");
+    printf("%-22s %-10s %-10s %-8s %s\n", "Method", "Keys", "Time (s)", "Height", "Valid");
+    
+    avl_balancing = true;
+    BSTNode* inserted = NULL;
+    NodePool inserted_pool = NODE_POOL_INITIALIZER(BSTNode);
+    clock_t start = clock();
+    for (int i = 0; i < n; i++) {
+        inserted = insert_iterative(&inserted_pool, inserted, keys[i]);
+    }
+    double time_taken = ((double)(clock() - start)) / CLOCKS_PER_SEC;
+    printf("%-22s %-10d %-10.4f %-8d %s\n", "insert_iterative (AVL)", n, time_taken,
+           node_height(inserted), tree_size(inserted) == n && is_valid_bst(inserted) ? "Yes" : "No");
+    
+    NodePool built_pool = NODE_POOL_INITIALIZER(BSTNode);
+    start = clock();
+    BSTNode* built = build_from_sorted(&built_pool, keys, n);
+    time_taken = ((double)(clock() - start)) / CLOCKS_PER_SEC;
+    printf("%-22s %-10d %-10.4f %-8d %s\n", "build_from_sorted", n, time_taken,
+           node_height(built), tree_size(built) == n && is_valid_bst(built) ? "Yes" : "No");
+    free_tree(&built_pool, built);
+    
+    start = clock();
+    inserted = rebalance(inserted);
+    time_taken = ((double)(clock() - start)) / CLOCKS_PER_SEC;
+    printf("%-22s %-10d %-10.4f %-8d %s\n", "rebalance (AVL)", n, time_taken,
+           node_height(inserted), tree_size(inserted) == n && is_valid_bst(inserted) ? "Yes" : "No");
+    free_tree(&inserted_pool, inserted);
+    
+    avl_balancing = false;
+    BSTNode* plain = NULL;
+    NodePool plain_pool = NODE_POOL_INITIALIZER(BSTNode);
+    for (int i = 0; i < plain_n; i++) {
+        plain = insert_iterative(&plain_pool, plain, keys[i]);
+    }
+    int plain_height = tree_height(plain);
+    start = clock();
+    plain = rebalance(plain);
+    time_taken = ((double)(clock() - start)) / CLOCKS_PER_SEC;
+    printf("%-22s %-10d %-10.4f %d -> %-3d %s\n", "rebalance (plain)", plain_n, time_taken,
+           plain_height, tree_height(plain), tree_size(plain) == plain_n && is_valid_bst(plain) ? "Yes" : "No");
+    free_tree(&plain_pool, plain);
+    
+    printf("Minimum possible height for %d keys: %d\n", n, min_height);
+    
+    avl_balancing = saved_mode;
+    free(keys);
+}
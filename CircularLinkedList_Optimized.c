@@ -1,6 +1,9 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <limits.h>
+
+#include "MemoryPool.h"
 
 // Node structure for circular linked list
 typedef struct Node {
@@ -12,6 +15,7 @@ typedef struct Node {
 typedef struct CircularLinkedList {
     Node* last;  // Points to the last node (tail)
     int size;
+    NodePool node_pool;  // Per-list node pool, see MemoryPool.h
 } CircularLinkedList;
 
 // Function prototypes
@@ -60,7 +64,8 @@ double calculate_average(CircularLinkedList* list);
 int count_occurrences(CircularLinkedList* list, int value);
 
 // Helper functions
-Node* create_node(int data);
+Node* create_node(CircularLinkedList* list, int data);
+void free_node(CircularLinkedList* list, Node* node);
 Node* get_node_at_position(CircularLinkedList* list, int position);
 void print_list_info(CircularLinkedList* list);
 
@@ -436,6 +441,7 @@ CircularLinkedList* create_list() {
     if (list) {
         list->last = NULL;
         list->size = 0;
+        pool_init(&list->node_pool, sizeof(Node));
     }
     return list;
 }
@@ -443,10 +449,14 @@ CircularLinkedList* create_list() {
 void free_list(CircularLinkedList* list) {
     if (!list) return;
     
-    while (!is_empty(list)) {
-        delete_from_beginning(list);
+    // Pooled nodes are released with their blocks
+    if (!pool_owns_nodes(&list->node_pool)) {
+        while (!is_empty(list)) {
+            delete_from_beginning(list);
+        }
     }
     
+    pool_destroy(&list->node_pool);
     free(list);
 }
 
@@ -458,8 +468,8 @@ int get_size(CircularLinkedList* list) {
     return list->size;
 }
 
-Node* create_node(int data) {
-    Node* new_node = (Node*)malloc(sizeof(Node));
+Node* create_node(CircularLinkedList* list, int data) {
+    Node* new_node = (Node*)pool_alloc(&list->node_pool);
     if (new_node) {
         new_node->data = data;
         new_node->next = NULL;
@@ -467,9 +477,13 @@ Node* create_node(int data) {
     return new_node;
 }
 
+void free_node(CircularLinkedList* list, Node* node) {
+    pool_free(&list->node_pool, node);
+}
+
 // Insertion operations
 bool insert_at_beginning(CircularLinkedList* list, int data) {
-    Node* new_node = create_node(data);
+    Node* new_node = create_node(list, data);
     if (!new_node) return false;
     
     if (is_empty(list)) {
@@ -485,7 +499,7 @@ bool insert_at_beginning(CircularLinkedList* list, int data) {
 }
 
 bool insert_at_end(CircularLinkedList* list, int data) {
-    Node* new_node = create_node(data);
+    Node* new_node = create_node(list, data);
     if (!new_node) return false;
     
     if (is_empty(list)) {
@@ -514,7 +528,7 @@ bool insert_at_position(CircularLinkedList* list, int data, int position) {
         return insert_at_end(list, data);
     }
     
-    Node* new_node = create_node(data);
+    Node* new_node = create_node(list, data);
     if (!new_node) return false;
     
     Node* current = list->last->next; // Start from first node
@@ -535,7 +549,7 @@ bool insert_after_value(CircularLinkedList* list, int data, int target_value) {
     Node* current = list->last->next; // Start from first node
     do {
         if (current->data == target_value) {
-            Node* new_node = create_node(data);
+            Node* new_node = create_node(list, data);
             if (!new_node) return false;
             
             new_node->next = current->next;
@@ -565,7 +579,7 @@ bool insert_before_value(CircularLinkedList* list, int data, int target_value) {
     Node* current = list->last->next; // Start from first node
     do {
         if (current->next->data == target_value) {
-            Node* new_node = create_node(data);
+            Node* new_node = create_node(list, data);
             if (!new_node) return false;
             
             new_node->next = current->next;
@@ -586,11 +600,11 @@ bool delete_from_beginning(CircularLinkedList* list) {
     Node* first = list->last->next;
     
     if (first == list->last) { // Only one node
-        free(first);
+        free_node(list, first);
         list->last = NULL;
     } else {
         list->last->next = first->next;
-        free(first);
+        free_node(list, first);
     }
     
     list->size--;
@@ -601,7 +615,7 @@ bool delete_from_end(CircularLinkedList* list) {
     if (is_empty(list)) return false;
     
     if (list->last->next == list->last) { // Only one node
-        free(list->last);
+        free_node(list, list->last);
         list->last = NULL;
     } else {
         Node* current = list->last->next;
@@ -610,7 +624,7 @@ bool delete_from_end(CircularLinkedList* list) {
         }
         
         current->next = list->last->next;
-        free(list->last);
+        free_node(list, list->last);
         list->last = current;
     }
     
@@ -639,7 +653,7 @@ bool delete_at_position(CircularLinkedList* list, int position) {
         list->last = current;
     }
     
-    free(to_delete);
+    free_node(list, to_delete);
     list->size--;
     
     return true;
@@ -663,7 +677,7 @@ bool delete_by_value(CircularLinkedList* list, int value) {
                 list->last = current;
             }
             
-            free(to_delete);
+            free_node(list, to_delete);
             list->size--;
             return true;
         }
@@ -859,7 +873,7 @@ void remove_duplicates(CircularLinkedList* list) {
                     list->last = runner;
                 }
                 
-                free(duplicate);
+                free_node(list, duplicate);
                 list->size--;
             } else {
                 runner = runner->next;
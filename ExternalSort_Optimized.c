@@ -0,0 +1,559 @@
+// External merge sort for binary files of 32-bit keys that do not fit in RAM.
+//
+// Build:
+//   gcc -std=c99 -Wall -Wextra -O2 -pthread ExternalSort_Optimized.c -o external_sort
+//
+// The input is read in chunks of --memory bytes; each chunk is sorted with
+// quicksort_introsort (O(n log n) even on key dumps with few distinct
+// values) and written to a temporary run file. Runs are then merged
+// --fan-in at a time through a min-heap (the Heap type from
+// HeapSort_PriorityQueue_Optimized.c, priority = key, data = run index),
+// with the memory budget split evenly between the input buffers and the
+// output buffer. When there are more runs than the fan-in, intermediate
+// passes merge groups into longer runs until one final pass remains.
+// Peak memory stays at roughly --memory regardless of the input size.
+//
+// Keys are native-endian int32, the same layout as fwrite() of an int[].
+//
+// Usage: external_sort [--memory SIZE] [--fan-in K] [--temp-dir DIR]
+//                      [--generate N] [--seed N] [--verify] INPUT OUTPUT
+//
+// SIZE accepts K, M and G suffixes. --generate first writes N random keys
+// to INPUT; --verify re-reads OUTPUT and checks order, count and checksum.
+
+#define QUICKSORT_NO_MAIN
+#include "QuickSort_Optimized.c"
+
+#define HEAPSORT_NO_MAIN
+#define print_array heap_print_array
+#include "HeapSort_PriorityQueue_Optimized.c"
+#undef print_array
+
+#define DEFAULT_MEMORY_BUDGET (256L * 1024 * 1024)
+#define MIN_MEMORY_BUDGET (64L * 1024)
+#define DEFAULT_FAN_IN 64
+#define MAX_FAN_IN 1024
+#define MAX_PATH_LENGTH 4096
+#define IO_BUFFER_ELEMENTS 65536
+
+typedef struct {
+    long memory;          // Bytes for key buffers in every phase
+    int fan_in;           // Runs merged per pass
+    const char* temp_dir;
+    long long generate;   // Keys to write to the input first; 0 = none
+    unsigned int seed;
+    bool verify;
+    const char* input;
+    const char* output;
+} ExternalSortOptions;
+
+// Buffered reader over one sorted run
+typedef struct {
+    FILE* file;
+    int* buffer;
+    size_t capacity;
+    size_t count;     // Keys currently in buffer
+    size_t pos;       // Next key to hand out
+} RunReader;
+
+// Order-independent summary of a key multiset, compared by --verify
+typedef struct {
+    long long count;
+    unsigned long long sum;
+    unsigned long long xor_mix;
+} KeyChecksum;
+
+typedef struct {
+    char** paths;
+    int count;
+    int capacity;
+} RunList;
+
+// Function prototypes
+void print_usage(const char* program);
+bool parse_options(int argc, char* argv[], ExternalSortOptions* options);
+bool parse_size(const char* text, long* bytes);
+bool generate_input(const char* path, long long count, unsigned int seed);
+bool external_sort(const ExternalSortOptions* options);
+bool create_runs(const ExternalSortOptions* options, RunList* runs, KeyChecksum* checksum,
+                 long long* total_keys);
+bool merge_runs(char* const inputs[], int count, const char* output_path, long memory);
+bool refill_reader(RunReader* reader);
+bool write_keys(FILE* file, const int keys[], size_t count);
+bool add_run(RunList* runs, const char* path);
+void free_runs(RunList* runs, bool remove_files);
+void make_run_path(char* path, const char* temp_dir, int pass, int index);
+void update_checksum(KeyChecksum* checksum, const int keys[], size_t count);
+bool verify_output(const char* path, const KeyChecksum* expected);
+
+int main(int argc, char* argv[]) {
+    ExternalSortOptions options;
+    
+    if (!parse_options(argc, argv, &options)) {
+        print_usage(argv[0]);
+        return 1;
+    }
+    
+    if (options.generate > 0) {
+        double start = get_wall_time();
+        if (!generate_input(options.input, options.generate, options.seed)) {
+            return 1;
+        }
+        fprintf(stderr, "Generated %lld keys in %s (%.3f s)\n",
+                options.generate, options.input, get_wall_time() - start);
+    }
+    
+    return external_sort(&options) ? 0 : 1;
+}
+
+void print_usage(const char* program) {
+    fprintf(stderr,
+            "Usage: %s [options] INPUT OUTPUT\n"
+            "  --memory SIZE    key buffer budget, K/M/G suffixes allowed (default 256M)\n"
+            "  --fan-in K       runs merged per pass, 2..%d (default %d)\n"
+            "  --temp-dir DIR   directory for run files (default: current directory)\n"
+            "  --generate N     write N random int32 keys to INPUT before sorting\n"
+            "  --seed N         seed for --generate (default %u)\n"
+            "  --verify         check OUTPUT's order, key count and checksum\n",
+            program, MAX_FAN_IN, DEFAULT_FAN_IN, BENCHMARK_SEED);
+}
+
+bool parse_options(int argc, char* argv[], ExternalSortOptions* options) {
+    options->memory = DEFAULT_MEMORY_BUDGET;
+    options->fan_in = DEFAULT_FAN_IN;
+    options->temp_dir = NULL;
+    options->generate = 0;
+    options->seed = BENCHMARK_SEED;
+    options->verify = false;
+    options->input = NULL;
+    options->output = NULL;
+    
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        
+        if (strcmp(arg, "--help") == 0 || strcmp(arg, "-h") == 0) {
+            return false;
+        }
+        if (strcmp(arg, "--verify") == 0) {
+            options->verify = true;
+            continue;
+        }
+        if (strncmp(arg, "--", 2) != 0) {
+            if (!options->input) {
+                options->input = arg;
+            } else if (!options->output) {
+                options->output = arg;
+            } else {
+                fprintf(stderr, "Unexpected argument: %s\n", arg);
+                return false;
+            }
+            continue;
+        }
+        
+        const char* value = i + 1 < argc ? argv[i + 1] : NULL;
+        if (!value) {
+            fprintf(stderr, "Missing value for %s\n", arg);
+            return false;
+        }
+        i++;
+        
+        if (strcmp(arg, "--memory") == 0) {
+            if (!parse_size(value, &options->memory)) {
+                fprintf(stderr, "Invalid size: %s\n", value);
+                return false;
+            }
+        } else if (strcmp(arg, "--fan-in") == 0) {
+            options->fan_in = atoi(value);
+        } else if (strcmp(arg, "--temp-dir") == 0) {
+            options->temp_dir = value;
+        } else if (strcmp(arg, "--generate") == 0) {
+            options->generate = atoll(value);
+        } else if (strcmp(arg, "--seed") == 0) {
+            options->seed = (unsigned int)strtoul(value, NULL, 10);
+        } else {
+            fprintf(stderr, "Unknown option: %s\n", arg);
+            return false;
+        }
+    }
+    
+    if (!options->input || !options->output) {
+        fprintf(stderr, "INPUT and OUTPUT are required\n");
+        return false;
+    }
+    if (options->memory < MIN_MEMORY_BUDGET) {
+        fprintf(stderr, "Memory budget must be at least %ldK\n", MIN_MEMORY_BUDGET / 1024);
+        return false;
+    }
+    if (options->fan_in < 2 || options->fan_in > MAX_FAN_IN) {
+        fprintf(stderr, "Fan-in must be 2..%d\n", MAX_FAN_IN);
+        return false;
+    }
+    if (options->generate < 0) {
+        fprintf(stderr, "Key count for --generate must be non-negative\n");
+        return false;
+    }
+    
+    return true;
+}
+
+bool parse_size(const char* text, long* bytes) {
+    char* end;
+    long value = strtol(text, &end, 10);
+    
+    if (end == text || value <= 0) return false;
+    
+    switch (*end) {
+        case '\0': break;
+        case 'k': case 'K': value *= 1024L; end++; break;
+        case 'm': case 'M': value *= 1024L * 1024; end++; break;
+        case 'g': case 'G': value *= 1024L * 1024 * 1024; end++; break;
+        default: return false;
+    }
+    
+    *bytes = value;
+    return *end == '\0';
+}
+
+bool generate_input(const char* path, long long count, unsigned int seed) {
+    FILE* file = fopen(path, "wb");
+    int* buffer = (int*)malloc(IO_BUFFER_ELEMENTS * sizeof(int));
+    
+    if (!file || !buffer) {
+        fprintf(stderr, "Cannot create %s\n", path);
+        if (file) fclose(file);
+        free(buffer);
+        return false;
+    }
+    
+    srand(seed);
+    bool ok = true;
+    
+    for (long long written = 0; written < count && ok; ) {
+        long long remaining = count - written;
+        int chunk = remaining < IO_BUFFER_ELEMENTS ? (int)remaining : IO_BUFFER_ELEMENTS;
+        
+        generate_test_data(buffer, chunk, "full_range");
+        ok = write_keys(file, buffer, chunk);
+        written += chunk;
+    }
+    
+    free(buffer);
+    if (fclose(file) != 0) ok = false;
+    if (!ok) fprintf(stderr, "Write to %s failed\n", path);
+    
+    return ok;
+}
+
+bool external_sort(const ExternalSortOptions* options) {
+    RunList runs = {NULL, 0, 0};
+    KeyChecksum checksum = {0, 0, 0};
+    long long total_keys = 0;
+    int pass = 1;
+    
+    double start = get_wall_time();
+    if (!create_runs(options, &runs, &checksum, &total_keys)) {
+        free_runs(&runs, true);
+        return false;
+    }
+    double run_time = get_wall_time() - start;
+    
+    fprintf(stderr, "Run generation: %lld keys -> %d run(s) in %.3f s\n",
+            total_keys, runs.count == 0 ? 1 : runs.count, run_time);
+    
+    // Intermediate passes until a single merge can produce the output
+    while (runs.count > options->fan_in) {
+        RunList next = {NULL, 0, 0};
+        double pass_start = get_wall_time();
+        
+        for (int first = 0; first < runs.count; first += options->fan_in) {
+            int group = runs.count - first < options->fan_in ? runs.count - first : options->fan_in;
+            char path[MAX_PATH_LENGTH];
+            
+            make_run_path(path, options->temp_dir ? options->temp_dir : ".", pass, next.count);
+            if (!add_run(&next, path) ||
+                !merge_runs(runs.paths + first, group, path, options->memory)) {
+                free_runs(&next, true);
+                free_runs(&runs, true);
+                return false;
+            }
+        }
+        
+        fprintf(stderr, "Merge pass %d: %d runs -> %d runs in %.3f s\n",
+                pass, runs.count, next.count, get_wall_time() - pass_start);
+        
+        free_runs(&runs, true);
+        runs = next;
+        pass++;
+    }
+    
+    if (runs.count > 0) {
+        int final_runs = runs.count;
+        double pass_start = get_wall_time();
+        bool ok = merge_runs(runs.paths, runs.count, options->output, options->memory);
+        free_runs(&runs, true);
+        if (!ok) return false;
+        
+        fprintf(stderr, "Final merge: %d run(s) in %.3f s\n",
+                final_runs, get_wall_time() - pass_start);
+    }
+    
+    double total_time = get_wall_time() - start;
+    fprintf(stderr, "Total: %.3f s (%.1f ns/key)\n", total_time,
+            total_keys > 0 ? total_time * 1e9 / (double)total_keys : 0.0);
+    
+    if (options->verify) {
+        bool ok = verify_output(options->output, &checksum);
+        fprintf(stderr, "Verification: %s\n", ok ? "passed" : "FAILED");
+        return ok;
+    }
+    
+    return true;
+}
+
+// Sorts each memory-sized chunk of the input into a run file. An input that
+// fits in a single chunk is written straight to the output instead.
+bool create_runs(const ExternalSortOptions* options, RunList* runs, KeyChecksum* checksum,
+                 long long* total_keys) {
+    long capacity = options->memory / (long)sizeof(int);
+    if (capacity > MAX_PARALLEL_SIZE) capacity = MAX_PARALLEL_SIZE;
+    
+    FILE* input = fopen(options->input, "rb");
+    if (!input) {
+        fprintf(stderr, "Cannot open %s\n", options->input);
+        return false;
+    }
+    
+    int* chunk = (int*)malloc(capacity * sizeof(int));
+    if (!chunk) {
+        fprintf(stderr, "Memory allocation failed for %ld keys\n", capacity);
+        fclose(input);
+        return false;
+    }
+    
+    bool ok = true;
+    bool first_chunk = true;
+    
+    while (ok) {
+        size_t bytes = fread(chunk, 1, capacity * sizeof(int), input);
+        size_t count = bytes / sizeof(int);
+        
+        if (ferror(input)) {
+            fprintf(stderr, "Read from %s failed\n", options->input);
+            ok = false;
+            break;
+        }
+        if (bytes % sizeof(int) != 0) {
+            fprintf(stderr, "%s is not a whole number of 32-bit keys\n", options->input);
+            ok = false;
+            break;
+        }
+        
+        // A full chunk is the last one only if nothing follows it
+        bool last_chunk = count < (size_t)capacity;
+        if (!last_chunk) {
+            int next = fgetc(input);
+            if (next == EOF) {
+                last_chunk = true;
+            } else {
+                ungetc(next, input);
+            }
+        }
+        
+        update_checksum(checksum, chunk, count);
+        *total_keys += (long long)count;
+        if (count > 1) {
+            quicksort_introsort(chunk, 0, (int)count - 1, MEDIAN_OF_THREE);
+        }
+        
+        char path[MAX_PATH_LENGTH];
+        const char* target = options->output;
+        
+        if (!(first_chunk && last_chunk)) {
+            make_run_path(path, options->temp_dir ? options->temp_dir : ".", 0, runs->count);
+            target = path;
+            if (!add_run(runs, path)) {
+                ok = false;
+                break;
+            }
+        }
+        
+        FILE* out = fopen(target, "wb");
+        if (!out) {
+            fprintf(stderr, "Cannot create %s\n", target);
+            ok = false;
+            break;
+        }
+        ok = write_keys(out, chunk, count);
+        if (fclose(out) != 0 || !ok) {
+            fprintf(stderr, "Write to %s failed\n", target);
+            ok = false;
+        }
+        
+        first_chunk = false;
+        if (last_chunk) break;
+    }
+    
+    free(chunk);
+    fclose(input);
+    return ok;
+}
+
+// k-way merge of sorted run files into output_path. The memory budget is
+// split into count + 1 equal buffers: one per input run plus the output.
+bool merge_runs(char* const inputs[], int count, const char* output_path, long memory) {
+    size_t buffer_keys = (size_t)(memory / (long)sizeof(int) / (count + 1));
+    if (buffer_keys == 0) buffer_keys = 1;
+    
+    RunReader* readers = (RunReader*)calloc(count, sizeof(RunReader));
+    int* output_buffer = (int*)malloc(buffer_keys * sizeof(int));
+    Heap* heap = create_heap(count, false);
+    FILE* out = fopen(output_path, "wb");
+    bool ok = readers && output_buffer && heap && out;
+    
+    if (!out) fprintf(stderr, "Cannot create %s\n", output_path);
+    
+    for (int r = 0; ok && r < count; r++) {
+        readers[r].file = fopen(inputs[r], "rb");
+        readers[r].buffer = (int*)malloc(buffer_keys * sizeof(int));
+        readers[r].capacity = buffer_keys;
+        
+        if (!readers[r].file || !readers[r].buffer) {
+            fprintf(stderr, "Cannot open run %s\n", inputs[r]);
+            ok = false;
+        } else if (refill_reader(&readers[r])) {
+            insert_heap(heap, r, readers[r].buffer[0]);
+        }
+    }
+    
+    size_t pending = 0;
+    
+    while (ok && !is_heap_empty(heap)) {
+        // The smallest head is emitted, then replaced by its run's next key
+        int r = peek_heap(heap).data;
+        RunReader* reader = &readers[r];
+        
+        output_buffer[pending++] = reader->buffer[reader->pos++];
+        if (pending == buffer_keys) {
+            ok = write_keys(out, output_buffer, pending);
+            pending = 0;
+        }
+        
+        if (reader->pos < reader->count || refill_reader(reader)) {
+            heap->elements[0].priority = reader->buffer[reader->pos];
+            heapify_down(heap, 0);
+        } else {
+            extract_heap(heap);
+        }
+    }
+    
+    if (ok && pending > 0) {
+        ok = write_keys(out, output_buffer, pending);
+    }
+    if (out && fclose(out) != 0) ok = false;
+    if (!ok && out) fprintf(stderr, "Merge into %s failed\n", output_path);
+    
+    for (int r = 0; readers && r < count; r++) {
+        if (readers[r].file) fclose(readers[r].file);
+        free(readers[r].buffer);
+    }
+    free(readers);
+    free(output_buffer);
+    free_heap(heap);
+    
+    return ok;
+}
+
+// Loads the next block of a run; false once the run is exhausted
+bool refill_reader(RunReader* reader) {
+    reader->count = fread(reader->buffer, sizeof(int), reader->capacity, reader->file);
+    reader->pos = 0;
+    
+    return reader->count > 0;
+}
+
+bool write_keys(FILE* file, const int keys[], size_t count) {
+    return fwrite(keys, sizeof(int), count, file) == count;
+}
+
+bool add_run(RunList* runs, const char* path) {
+    if (runs->count == runs->capacity) {
+        int capacity = runs->capacity ? runs->capacity * 2 : 16;
+        char** paths = (char**)realloc(runs->paths, capacity * sizeof(char*));
+        if (!paths) {
+            fprintf(stderr, "Memory allocation failed for run list\n");
+            return false;
+        }
+        runs->paths = paths;
+        runs->capacity = capacity;
+    }
+    
+    runs->paths[runs->count] = (char*)malloc(strlen(path) + 1);
+    if (!runs->paths[runs->count]) {
+        fprintf(stderr, "Memory allocation failed for run list\n");
+        return false;
+    }
+    strcpy(runs->paths[runs->count], path);
+    runs->count++;
+    
+    return true;
+}
+
+void free_runs(RunList* runs, bool remove_files) {
+    for (int i = 0; i < runs->count; i++) {
+        if (remove_files) remove(runs->paths[i]);
+        free(runs->paths[i]);
+    }
+    free(runs->paths);
+    runs->paths = NULL;
+    runs->count = 0;
+    runs->capacity = 0;
+}
+
+// Run files are named per process so concurrent sorts can share a directory
+void make_run_path(char* path, const char* temp_dir, int pass, int index) {
+    snprintf(path, MAX_PATH_LENGTH, "%s/extsort_%ld_p%d_r%d.run",
+             temp_dir, (long)getpid(), pass, index);
+}
+
+void update_checksum(KeyChecksum* checksum, const int keys[], size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        unsigned long long key = (unsigned int)keys[i];
+        checksum->sum += key;
+        checksum->xor_mix ^= key * 0x9E3779B97F4A7C15ULL;
+    }
+    checksum->count += (long long)count;
+}
+
+// Streams the output once, checking order across buffer boundaries and
+// comparing count and checksum against the input's
+bool verify_output(const char* path, const KeyChecksum* expected) {
+    FILE* file = fopen(path, "rb");
+    int* buffer = (int*)malloc(IO_BUFFER_ELEMENTS * sizeof(int));
+    KeyChecksum actual = {0, 0, 0};
+    bool ordered = true;
+    bool have_previous = false;
+    int previous = 0;
+    
+    if (!file || !buffer) {
+        fprintf(stderr, "Cannot read %s\n", path);
+        if (file) fclose(file);
+        free(buffer);
+        return false;
+    }
+    
+    size_t count;
+    while ((count = fread(buffer, sizeof(int), IO_BUFFER_ELEMENTS, file)) > 0) {
+        if (have_previous && buffer[0] < previous) ordered = false;
+        if (!is_sorted(buffer, (int)count)) ordered = false;
+        
+        update_checksum(&actual, buffer, count);
+        previous = buffer[count - 1];
+        have_previous = true;
+    }
+    
+    fclose(file);
+    free(buffer);
+    
+    return ordered && actual.count == expected->count && actual.sum == expected->sum &&
+           actual.xor_mix == expected->xor_mix;
+}
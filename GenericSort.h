@@ -0,0 +1,346 @@
+#ifndef GENERIC_SORT_H
+#define GENERIC_SORT_H
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+// Type-specialised sorting for arbitrary element types.
+//
+// DEFINE_SORT(name, type, less) expands to
+//     void name_sort(type arr[], int low, int high);
+// which sorts arr[low..high] in place. less(a, b) is an expression on two
+// elements (values, not pointers) that is true when a orders before b:
+//
+//     typedef struct { int key; int id; } Record;
+//     #define RECORD_LESS(a, b) ((a).key < (b).key)
+//     DEFINE_SORT(record, Record, RECORD_LESS)
+//
+// Every comparison is expanded in place, so unlike qsort() there is no
+// call through a function pointer per compare. The algorithm is a classic
+// introsort: median-of-three Hoare partitioning, recursing into the smaller
+// side, insertion sort for ranges of up to GENERIC_SORT_THRESHOLD elements
+// and a heap sort fallback once the recursion depth passes 2 log2 n, so the
+// worst case is O(n log n). The sort is not stable.
+//
+// DEFINE_STABLE_SORT(name, type, less) expands to
+//     bool name_stable_sort(type arr[], int low, int high, int num_threads);
+// a stable merge sort that uses an n-element scratch buffer and returns
+// false (leaving arr untouched) if it cannot be allocated. Halves larger
+// than STABLE_SORT_PARALLEL_CUTOFF are sorted on separate threads and
+// merged in parallel: the output is cut into one slice per thread and the
+// matching input split points are found by co-ranking (a binary search
+// along the merge diagonal), so no thread waits on another.
+
+#define GENERIC_SORT_THRESHOLD 16
+#define STABLE_SORT_RUN 32
+#define STABLE_SORT_PARALLEL_CUTOFF 16384
+
+#define DEFINE_SORT(name, type, less)                                          \
+                                                                               \
+static inline void name##_insertion_sort(type arr[], int low, int high) {      \
+    for (int i = low + 1; i <= high; i++) {                                    \
+        type key = arr[i];                                                     \
+        int j = i - 1;                                                         \
+        while (j >= low && less(key, arr[j])) {                                \
+            arr[j + 1] = arr[j];                                               \
+            j--;                                                               \
+        }                                                                      \
+        arr[j + 1] = key;                                                      \
+    }                                                                          \
+}                                                                              \
+                                                                               \
+static inline void name##_sift_down(type arr[], int n, int root) {             \
+    type value = arr[root];                                                    \
+    while (2 * root + 1 < n) {                                                 \
+        int child = 2 * root + 1;                                              \
+        if (child + 1 < n && less(arr[child], arr[child + 1])) {               \
+            child++;                                                           \
+        }                                                                      \
+        if (!less(value, arr[child])) {                                        \
+            break;                                                             \
+        }                                                                      \
+        arr[root] = arr[child];                                                \
+        root = child;                                                          \
+    }                                                                          \
+    arr[root] = value;                                                         \
+}                                                                              \
+                                                                               \
+static inline void name##_heap_sort(type arr[], int low, int high) {           \
+    type* base = arr + low;                                                    \
+    int n = high - low + 1;                                                    \
+    for (int i = n / 2 - 1; i >= 0; i--) {                                     \
+        name##_sift_down(base, n, i);                                          \
+    }                                                                          \
+    for (int i = n - 1; i > 0; i--) {                                          \
+        type temp = base[0];                                                   \
+        base[0] = base[i];                                                     \
+        base[i] = temp;                                                        \
+        name##_sift_down(base, i, 0);                                          \
+    }                                                                          \
+}                                                                              \
+                                                                               \
+/* Orders arr[low], arr[mid], arr[high] and returns the median's value */      \
+static inline type name##_median_of_three(type arr[], int low, int high) {     \
+    int mid = low + (high - low) / 2;                                          \
+    type temp;                                                                 \
+    if (less(arr[mid], arr[low])) {                                            \
+        temp = arr[low]; arr[low] = arr[mid]; arr[mid] = temp;                 \
+    }                                                                          \
+    if (less(arr[high], arr[mid])) {                                           \
+        temp = arr[mid]; arr[mid] = arr[high]; arr[high] = temp;               \
+    }                                                                          \
+    if (less(arr[mid], arr[low])) {                                            \
+        temp = arr[low]; arr[low] = arr[mid]; arr[mid] = temp;                 \
+    }                                                                          \
+    return arr[mid];                                                           \
+}                                                                              \
+                                                                               \
+static inline void name##_sort_loop(type arr[], int low, int high,             \
+                                    int depth_limit) {                         \
+    while (high - low + 1 > GENERIC_SORT_THRESHOLD) {                          \
+        if (depth_limit-- == 0) {                                              \
+            name##_heap_sort(arr, low, high);                                  \
+            return;                                                            \
+        }                                                                      \
+                                                                               \
+        type pivot = name##_median_of_three(arr, low, high);                   \
+        int i = low - 1;                                                       \
+        int j = high + 1;                                                      \
+        while (1) {                                                            \
+            do { i++; } while (less(arr[i], pivot));                           \
+            do { j--; } while (less(pivot, arr[j]));                           \
+            if (i >= j) break;                                                 \
+            type temp = arr[i];                                                \
+            arr[i] = arr[j];                                                   \
+            arr[j] = temp;                                                     \
+        }                                                                      \
+                                                                               \
+        /* Hoare split: arr[low..j] <= pivot <= arr[j+1..high] */              \
+        if (j - low < high - j) {                                              \
+            name##_sort_loop(arr, low, j, depth_limit);                        \
+            low = j + 1;                                                       \
+        } else {                                                               \
+            name##_sort_loop(arr, j + 1, high, depth_limit);                   \
+            high = j;                                                          \
+        }                                                                      \
+    }                                                                          \
+    if (low < high) {                                                          \
+        name##_insertion_sort(arr, low, high);                                 \
+    }                                                                          \
+}                                                                              \
+                                                                               \
+static inline void name##_sort(type arr[], int low, int high) {                \
+    if (low < high) {                                                          \
+        int depth_limit = 0;                                                   \
+        for (int n = high - low + 1; n > 1; n >>= 1) {                         \
+            depth_limit += 2;                                                  \
+        }                                                                      \
+        name##_sort_loop(arr, low, high, depth_limit);                         \
+    }                                                                          \
+}                                                                              \
+                                                                               \
+static inline bool name##_is_sorted(type arr[], int size) {                    \
+    for (int i = 1; i < size; i++) {                                           \
+        if (less(arr[i], arr[i - 1])) {                                        \
+            return false;                                                      \
+        }                                                                      \
+    }                                                                          \
+    return true;                                                               \
+}
+
+#define DEFINE_STABLE_SORT(name, type, less)                                   \
+                                                                               \
+typedef struct {                                                               \
+    type* src;                                                                 \
+    type* dst;                                                                 \
+    int n;                                                                     \
+    int threads;                                                               \
+    bool to_dst;  /* Result goes to dst rather than src */                     \
+} name##_StableTask;                                                           \
+                                                                               \
+typedef struct {                                                               \
+    const type* a;                                                             \
+    int na;                                                                    \
+    const type* b;                                                             \
+    int nb;                                                                    \
+    type* out;                                                                 \
+} name##_MergeTask;                                                            \
+                                                                               \
+/* Insertion sort with a strict comparison, so equal elements keep order */    \
+static inline void name##_stable_insertion_sort(type arr[], int n) {           \
+    for (int i = 1; i < n; i++) {                                              \
+        type key = arr[i];                                                     \
+        int j = i - 1;                                                         \
+        while (j >= 0 && less(key, arr[j])) {                                  \
+            arr[j + 1] = arr[j];                                               \
+            j--;                                                               \
+        }                                                                      \
+        arr[j + 1] = key;                                                      \
+    }                                                                          \
+}                                                                              \
+                                                                               \
+/* Ties take from a first, which is what makes the merge stable */             \
+static inline void name##_merge_sequential(const type* a, int na,              \
+                                           const type* b, int nb, type* out) { \
+    int i = 0, j = 0, k = 0;                                                   \
+    while (i < na && j < nb) {                                                 \
+        if (less(b[j], a[i])) {                                                \
+            out[k++] = b[j++];                                                 \
+        } else {                                                               \
+            out[k++] = a[i++];                                                 \
+        }                                                                      \
+    }                                                                          \
+    memcpy(out + k, a + i, (na - i) * sizeof(type));                           \
+    memcpy(out + k + na - i, b + j, (nb - j) * sizeof(type));                  \
+}                                                                              \
+                                                                               \
+/* Co-rank: how many elements of a precede output position k in the */         \
+/* stable merge of a and b, found by binary search on the diagonal */          \
+static inline int name##_co_rank(int k, const type* a, int na, const type* b,  \
+                                 int nb) {                                     \
+    int i = k < na ? k : na;                                                   \
+    int j = k - i;                                                             \
+    int i_low = k - nb > 0 ? k - nb : 0;                                       \
+    int j_low = k - na > 0 ? k - na : 0;                                       \
+                                                                               \
+    while (1) {                                                                \
+        if (i > 0 && j < nb && less(b[j], a[i - 1])) {                         \
+            int delta = (i - i_low + 1) / 2;                                   \
+            j_low = j;                                                         \
+            i -= delta;                                                        \
+            j += delta;                                                        \
+        } else if (j > 0 && i < na && !less(b[j - 1], a[i])) {                 \
+            int delta = (j - j_low + 1) / 2;                                   \
+            i_low = i;                                                         \
+            i += delta;                                                        \
+            j -= delta;                                                        \
+        } else {                                                               \
+            return i;                                                          \
+        }                                                                      \
+    }                                                                          \
+}                                                                              \
+                                                                               \
+static void* name##_merge_task(void* arg) {                                    \
+    name##_MergeTask* task = (name##_MergeTask*)arg;                           \
+    name##_merge_sequential(task->a, task->na, task->b, task->nb, task->out);  \
+    return NULL;                                                               \
+}                                                                              \
+                                                                               \
+/* Splits the output into one equal slice per thread; co-ranking finds */      \
+/* where each slice starts in a and b, so the slices merge independently */    \
+static inline void name##_merge_parallel(const type* a, int na, const type* b, \
+                                         int nb, type* out, int threads) {     \
+    int total = na + nb;                                                       \
+    name##_MergeTask* tasks = NULL;                                            \
+    pthread_t* handles = NULL;                                                 \
+                                                                               \
+    if (threads > 1 && total >= STABLE_SORT_PARALLEL_CUTOFF) {                 \
+        tasks = (name##_MergeTask*)malloc(threads * sizeof(name##_MergeTask)); \
+        handles = (pthread_t*)malloc(threads * sizeof(pthread_t));             \
+    }                                                                          \
+    if (!tasks || !handles) {                                                  \
+        free(tasks);                                                           \
+        free(handles);                                                         \
+        name##_merge_sequential(a, na, b, nb, out);                            \
+        return;                                                                \
+    }                                                                          \
+                                                                               \
+    int i_start = 0;                                                           \
+    for (int p = 0; p < threads; p++) {                                        \
+        int k_end = (int)((long long)total * (p + 1) / threads);               \
+        int i_end = name##_co_rank(k_end, a, na, b, nb);                       \
+        int k_start = (int)((long long)total * p / threads);                   \
+        tasks[p].a = a + i_start;                                              \
+        tasks[p].na = i_end - i_start;                                         \
+        tasks[p].b = b + (k_start - i_start);                                  \
+        tasks[p].nb = (k_end - i_end) - (k_start - i_start);                   \
+        tasks[p].out = out + k_start;                                          \
+        i_start = i_end;                                                       \
+    }                                                                          \
+                                                                               \
+    int spawned = 1;                                                           \
+    for (int p = 1; p < threads; p++) {                                        \
+        if (pthread_create(&handles[p], NULL, name##_merge_task,               \
+                           &tasks[p]) != 0) {                                  \
+            break;                                                             \
+        }                                                                      \
+        spawned++;                                                             \
+    }                                                                          \
+    for (int p = spawned; p < threads; p++) {                                  \
+        name##_merge_task(&tasks[p]);                                          \
+    }                                                                          \
+    name##_merge_task(&tasks[0]);                                              \
+    for (int p = 1; p < spawned; p++) {                                        \
+        pthread_join(handles[p], NULL);                                        \
+    }                                                                          \
+                                                                               \
+    free(tasks);                                                               \
+    free(handles);                                                             \
+}                                                                              \
+                                                                               \
+/* Sorts task->src[0..n-1], leaving the result in src or dst. Each level */    \
+/* sorts its halves into the other buffer and merges back, so data moves */    \
+/* once per level; halves above the cutoff run on their own thread. */         \
+static void* name##_stable_sort_task(void* arg) {                              \
+    name##_StableTask* task = (name##_StableTask*)arg;                         \
+    int n = task->n;                                                           \
+    type* target = task->to_dst ? task->dst : task->src;                       \
+    type* from = task->to_dst ? task->src : task->dst;                         \
+                                                                               \
+    if (n <= STABLE_SORT_RUN) {                                                \
+        if (task->to_dst) {                                                    \
+            memcpy(task->dst, task->src, n * sizeof(type));                    \
+        }                                                                      \
+        name##_stable_insertion_sort(target, n);                               \
+        return NULL;                                                           \
+    }                                                                          \
+                                                                               \
+    int half = n / 2;                                                          \
+    int left_threads = task->threads > 1 ? task->threads / 2 : 1;              \
+    int right_threads = task->threads > 1 ? task->threads - left_threads : 1;  \
+    name##_StableTask left = {task->src, task->dst, half, left_threads,        \
+                              !task->to_dst};                                  \
+    name##_StableTask right = {task->src + half, task->dst + half, n - half,   \
+                               right_threads, !task->to_dst};                  \
+    pthread_t handle;                                                          \
+    bool spawned = task->threads > 1 && n >= STABLE_SORT_PARALLEL_CUTOFF &&    \
+                   pthread_create(&handle, NULL, name##_stable_sort_task,      \
+                                  &left) == 0;                                 \
+                                                                               \
+    if (!spawned) {                                                            \
+        name##_stable_sort_task(&left);                                        \
+    }                                                                          \
+    name##_stable_sort_task(&right);                                           \
+    if (spawned) {                                                             \
+        pthread_join(handle, NULL);                                            \
+    }                                                                          \
+                                                                               \
+    /* Halves already in order (e.g. presorted input) need only a copy */      \
+    if (!less(from[half], from[half - 1])) {                                   \
+        memcpy(target, from, n * sizeof(type));                                \
+    } else {                                                                   \
+        name##_merge_parallel(from, half, from + half, n - half, target,       \
+                              task->threads);                                  \
+    }                                                                          \
+    return NULL;                                                               \
+}                                                                              \
+                                                                               \
+static inline bool name##_stable_sort(type arr[], int low, int high,           \
+                                      int num_threads) {                       \
+    int n = high - low + 1;                                                    \
+    if (n <= 1) return true;                                                   \
+                                                                               \
+    type* buffer = (type*)malloc(n * sizeof(type));                            \
+    if (!buffer) return false;                                                 \
+                                                                               \
+    name##_StableTask task = {arr + low, buffer, n,                            \
+                              num_threads > 0 ? num_threads : 1, false};       \
+    name##_stable_sort_task(&task);                                            \
+                                                                               \
+    free(buffer);                                                              \
+    return true;                                                               \
+}
+
+#endif
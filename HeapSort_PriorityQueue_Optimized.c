@@ -1,10 +1,25 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "PerfCounters.h"
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
 #include <string.h>
+#include <stdint.h>
+#include <limits.h>
 #include <time.h>
+#include <pthread.h>
+#include <unistd.h>
 
 #define MAX_HEAP_SIZE 1000
+#define INITIAL_HEAP_CAPACITY 16
+#define CACHE_LINE_SIZE 64
+#define MAX_HEAP_ARITY 8
+#define BOTTOM_UP_EXTRACT_LIMIT 262144  // Elements (2 MiB): about an L2 cache
+#define BATCH_HEAPIFY_MIN 64             // insert_batch re-heapifies from this size
+#define PARALLEL_HEAP_BUILD_CUTOFF 65536 // Smaller heap sorts build sequentially
+#define MAX_BUILD_THREADS 64
 
 // Priority Queue element structure
 typedef struct {
@@ -12,33 +27,201 @@ typedef struct {
     int priority;
 } PQElement;
 
-// Heap structure for both max heap and min heap
+// Heap structure for both max heap and min heap. Children of node i are
+// arity * i + 1 .. arity * i + arity; elements is offset into storage so
+// that elements[1] starts a cache line, which puts each sibling group of
+// a 4-ary or 8-ary heap in a single line.
+//
+// A full heap doubles its capacity on insert (amortised O(1) per insert).
+// Extraction never copies: with shrink_on_drain set, the array is only
+// cut back to initial_capacity once the heap is empty, when nothing has
+// to move. reserve_heap and shrink_heap_to_fit resize explicitly.
+//
+// Heaps from create_indexed_heap also track a handle per element:
+// insert_heap_handle returns it, and decrease_key, increase_key and
+// remove_heap_handle find the element through positions in O(1) before an
+// O(log n) sift. Every move inside a sift updates the map. A handle stays
+// valid until its element is extracted or removed, and may then be reused.
 typedef struct {
     PQElement* elements;
+    PQElement* storage; // Allocation backing elements (freed by free_heap)
     int size;
     int capacity;
-    bool is_max_heap; // true for max heap, false for min heap
+    int initial_capacity;
+    int arity;
+    bool is_max_heap;     // true for max heap, false for min heap
+    bool growable;        // false: insert fails when full (fixed capacity)
+    bool shrink_on_drain; // Release grown storage when the heap empties
+    int* positions;       // Indexed mode: handle -> index, -1 if free (else NULL)
+    int* slot_handles;    // Indexed mode: index -> handle
+    int* free_handles;    // Indexed mode: released handles, reused first
+    int free_count;
+    int next_handle;      // Handles below this have been issued
 } Heap;
 
+// Pairing heap: a heap-ordered multiway tree stored as child/sibling
+// links. insert and meld link two roots in O(1); extract pairs up the
+// root's children (amortised O(log n)).
+typedef struct PairingNode {
+    PQElement element;
+    struct PairingNode* child;
+    struct PairingNode* sibling;
+} PairingNode;
+
+typedef struct {
+    PairingNode* root;
+    int size;
+    bool is_max_heap;
+} PairingHeap;
+
+// Radix heap for monotone min-queues: no inserted priority may be below
+// the last one extracted. Bucket i holds keys whose highest bit differing
+// from last is bit i - 1 (bucket 0: equal to last). Extract empties the
+// lowest non-empty bucket into lower buckets, and each key only ever
+// moves down, so a key is touched at most 33 times over its life.
+#define RADIX_HEAP_BUCKETS 33
+
+typedef struct {
+    PQElement* items;
+    int size;
+    int capacity;
+} RadixBucket;
+
+typedef struct {
+    RadixBucket buckets[RADIX_HEAP_BUCKETS];
+    unsigned int last;  // Last extracted key, biased to unsigned order
+    int size;
+} RadixHeap;
+
+// One interface over the queue engines so workloads can swap them
+typedef enum {
+    PQ_ENGINE_BINARY,
+    PQ_ENGINE_DARY,     // 4-ary cache-aligned Heap
+    PQ_ENGINE_PAIRING,
+    PQ_ENGINE_RADIX,    // Min-queue with monotone priorities only
+    PQ_ENGINE_COUNT
+} PQEngine;
+
+typedef struct {
+    PQEngine engine;
+    union {
+        Heap* heap;
+        PairingHeap* pairing;
+        RadixHeap* radix;
+    } impl;
+} PriorityQueue;
+
+// MultiQueue: a relaxed concurrent priority queue built from num_shards
+// Heaps, each behind its own mutex. Insert locks a random free shard.
+// Extract samples two random shards, reads their cached tops without
+// locking and takes the better one, so threads rarely meet on one lock.
+//
+// Ordering is relaxed: an extract returns the best element of the shard
+// it picked, not necessarily the global best. With c shards the expected
+// rank of the returned element is O(c), and no element waits forever as
+// long as extracts continue. Each inserted element is extracted exactly
+// once. Extract only reports empty after locking every shard in turn and
+// finding all of them empty, which is exact when no thread is inserting
+// concurrently. Use about two shards per thread.
+typedef struct {
+    pthread_mutex_t lock;
+    Heap* heap;
+    int top;   // Cached top priority and size, read without the lock
+    int size;
+} __attribute__((aligned(CACHE_LINE_SIZE))) MultiQueueShard;
+
+typedef struct {
+    MultiQueueShard* shards;  // Cache-line aligned, one shard per line
+    void* storage;
+    int num_shards;
+    bool is_max_heap;
+} MultiQueue;
+
+// A contiguous block of subtree roots on the split level of a parallel
+// heap build
+typedef struct {
+    int* arr;
+    int n;
+    int first_root;
+    int last_root;
+} HeapBuildArgs;
+
 // Function prototypes for Heap operations
 Heap* create_heap(int capacity, bool is_max_heap);
+Heap* create_heap_dary(int capacity, bool is_max_heap, int arity);
+Heap* create_indexed_heap(int capacity, bool is_max_heap, int arity);
 void free_heap(Heap* heap);
 bool is_heap_empty(Heap* heap);
 bool is_heap_full(Heap* heap);
+bool resize_heap(Heap* heap, int capacity);
+bool reserve_heap(Heap* heap, int capacity);
+bool shrink_heap_to_fit(Heap* heap);
 void swap_elements(PQElement* a, PQElement* b);
+bool has_higher_priority(Heap* heap, int a, int b);
 int parent(int index);
 int left_child(int index);
 int right_child(int index);
 void heapify_up(Heap* heap, int index);
 void heapify_down(Heap* heap, int index);
+void heapify_up_recursive(Heap* heap, int index);
+void heapify_down_recursive(Heap* heap, int index);
 bool insert_heap(Heap* heap, int data, int priority);
+int insert_heap_handle(Heap* heap, int data, int priority);
+bool is_valid_handle(Heap* heap, int handle);
+bool decrease_key(Heap* heap, int handle, int new_priority);
+bool increase_key(Heap* heap, int handle, int new_priority);
+bool change_priority(Heap* heap, int handle, int new_priority);
+PQElement remove_heap_handle(Heap* heap, int handle);
+void set_slot_handle(Heap* heap, int index, int handle);
+void release_handle(Heap* heap, int index);
+bool resize_handle_maps(Heap* heap, int capacity);
 PQElement extract_heap(Heap* heap);
+PQElement extract_heap_top_down(Heap* heap);
+PQElement extract_heap_bottom_up(Heap* heap);
 PQElement peek_heap(Heap* heap);
 void print_heap(Heap* heap);
-void build_heap(Heap* heap, PQElement elements[], int n);
+bool build_heap(Heap* heap, PQElement elements[], int n);
+bool insert_batch(Heap* heap, const PQElement elements[], int k);
+int extract_top_k(Heap* heap, PQElement out[], int k);
+
+// Alternative priority queue engines
+PairingHeap* create_pairing_heap(bool is_max_heap);
+void free_pairing_heap(PairingHeap* heap);
+bool pairing_heap_insert(PairingHeap* heap, int data, int priority);
+PQElement pairing_heap_extract(PairingHeap* heap);
+void pairing_heap_meld(PairingHeap* heap, PairingHeap* other);
+PairingNode* pairing_link(PairingHeap* heap, PairingNode* a, PairingNode* b);
+RadixHeap* create_radix_heap();
+void free_radix_heap(RadixHeap* heap);
+bool radix_heap_insert(RadixHeap* heap, int data, int priority);
+bool radix_heap_extract(RadixHeap* heap, PQElement* out);
+bool radix_heap_peek(RadixHeap* heap, PQElement* out);
+unsigned int radix_key(int priority);
+int radix_bucket_index(unsigned int key, unsigned int last);
+bool radix_bucket_push(RadixBucket* bucket, PQElement element);
+bool radix_heap_refill(RadixHeap* heap);
+PriorityQueue* pq_create(PQEngine engine, bool is_max_heap);
+void pq_free(PriorityQueue* pq);
+bool pq_insert(PriorityQueue* pq, int data, int priority);
+bool pq_extract(PriorityQueue* pq, PQElement* out);
+bool pq_peek(PriorityQueue* pq, PQElement* out);
+int pq_size(PriorityQueue* pq);
+bool pq_is_empty(PriorityQueue* pq);
+const char* pq_engine_name(PQEngine engine);
+
+// Concurrent MultiQueue
+MultiQueue* create_multiqueue(int num_shards, bool is_max_heap);
+void free_multiqueue(MultiQueue* mq);
+bool mq_insert(MultiQueue* mq, unsigned int* rng, int data, int priority);
+bool mq_extract(MultiQueue* mq, unsigned int* rng, PQElement* out);
+unsigned int mq_random(unsigned int* state);
+void mq_update_cache(MultiQueueShard* shard);
 
 // Heap Sort functions
 void heap_sort_ascending(int arr[], int n);
+void heap_sort_ascending_parallel(int arr[], int n, int num_threads);
+void build_max_heap_parallel(int arr[], int n, int num_threads);
+void* heap_build_worker(void* arg);
 void heap_sort_descending(int arr[], int n);
 void heapify_array(int arr[], int n, int root);
 void print_array(int arr[], int n);
@@ -46,22 +229,42 @@ void print_array(int arr[], int n);
 // Priority Queue operations
 void priority_queue_demo();
 void heap_sort_demo();
+void benchmark_heap_arity(int max_size);
+void benchmark_sift_strategies(int n);
+void benchmark_heap_growth(int n);
+void benchmark_dijkstra(int vertices, int degree);
+void benchmark_pq_engines(int n);
+void benchmark_batch_ops(int n);
+void benchmark_concurrent_pq(int n, int max_threads);
+void* concurrent_pq_worker(void* arg);
+double heap_wall_time(void);
+void benchmark_parallel_heap_build(int n, int max_threads);
 
 // Utility functions
 void generate_random_array(int arr[], int n, int max_value);
 bool is_sorted_ascending(int arr[], int n);
 bool is_sorted_descending(int arr[], int n);
 
+#ifndef HEAPSORT_NO_MAIN
 int main() {
     int choice;
     
     printf("=== Optimized Heap Sort & Priority Queue ===\n");
+    srand(time(NULL));
     
     while (1) {
         printf("\n=== MAIN MENU ===\n");
         printf("1. Heap Sort Demonstration\n");
         printf("2. Priority Queue Operations\n");
-        printf("3. Exit\n");
+        printf("3. d-ary heap layout benchmark\n");
+        printf("4. Sift strategy microbenchmark\n");
+        printf("5. Growable queue burst benchmark\n");
+        printf("6. Indexed heap: Dijkstra decrease-key benchmark\n");
+        printf("7. Priority queue engine benchmark\n");
+        printf("8. Batch insert/extract benchmark\n");
+        printf("9. Concurrent MultiQueue vs locked heap benchmark\n");
+        printf("10. Parallel heap build benchmark\n");
+        printf("11. Exit\n");
         printf("Enter your choice: ");
         
         if (scanf("%d", &choice) != 1) {
@@ -77,7 +280,101 @@ int main() {
             case 2:
                 priority_queue_demo();
                 break;
-            case 3:
+            case 3: {
+                int max_size;
+                
+                printf("Enter largest heap size (1000000 to 100000000): ");
+                if (scanf("%d", &max_size) != 1 || max_size < 1000000 || max_size > 100000000) {
+                    printf("Invalid size!\n");
+                    break;
+                }
+                benchmark_heap_arity(max_size);
+                break;
+            }
+            case 4: {
+                int n;
+                
+                printf("Enter heap size (1000 to 100000000): ");
+                if (scanf("%d", &n) != 1 || n < 1000 || n > 100000000) {
+                    printf("Invalid size!\n");
+                    break;
+                }
+                benchmark_sift_strategies(n);
+                break;
+            }
+            case 5: {
+                int n;
+                
+                printf("Enter burst size (1000 to 100000000): ");
+                if (scanf("%d", &n) != 1 || n < 1000 || n > 100000000) {
+                    printf("Invalid size!\n");
+                    break;
+                }
+                benchmark_heap_growth(n);
+                break;
+            }
+            case 6: {
+                int vertices;
+                
+                // Path lengths stay below 1000 * vertices, within int priorities
+                printf("Enter vertex count (1000 to 2000000): ");
+                if (scanf("%d", &vertices) != 1 || vertices < 1000 || vertices > 2000000) {
+                    printf("Invalid size!\n");
+                    break;
+                }
+                benchmark_dijkstra(vertices, 8);
+                break;
+            }
+            case 7: {
+                int n;
+                
+                printf("Enter pending queue size (1000 to 100000): ");
+                if (scanf("%d", &n) != 1 || n < 1000 || n > 100000) {
+                    printf("Invalid size!\n");
+                    break;
+                }
+                benchmark_pq_engines(n);
+                break;
+            }
+            case 8: {
+                int n;
+                
+                printf("Enter resident heap size (1000 to 10000000): ");
+                if (scanf("%d", &n) != 1 || n < 1000 || n > 10000000) {
+                    printf("Invalid size!\n");
+                    break;
+                }
+                benchmark_batch_ops(n);
+                break;
+            }
+            case 9: {
+                int max_threads;
+                
+                printf("Enter maximum thread count (1 to 64): ");
+                if (scanf("%d", &max_threads) != 1 || max_threads < 1 || max_threads > 64) {
+                    printf("Invalid thread count!\n");
+                    break;
+                }
+                benchmark_concurrent_pq(100000, max_threads);
+                break;
+            }
+            case 10: {
+                int n, max_threads;
+                
+                printf("Enter array size (1000000 to 100000000): ");
+                if (scanf("%d", &n) != 1 || n < 1000000 || n > 100000000) {
+                    printf("Invalid size!\n");
+                    break;
+                }
+                printf("Enter maximum thread count (1 to %d): ", MAX_BUILD_THREADS);
+                if (scanf("%d", &max_threads) != 1 || max_threads < 1 || max_threads > MAX_BUILD_THREADS) {
+                    printf("Invalid thread count!\n");
+                    break;
+                }
+                benchmark_parallel_heap_build(n, max_threads);
+                break;
+            }
+            case 11:
                 printf("Exiting program...\n");
                 return 0;
             default:
@@ -87,6 +384,7 @@ int main() {
     
     return 0;
 }
+#endif
 
 void heap_sort_demo() {
     int choice, n;
@@ -181,9 +479,9 @@ void heap_sort_demo() {
                 
                 start = clock();
                 if (choice == 3) {
-                    heap_sort_ascending(arr, n);
+                    PERF_MEASURE("heap_sort_ascending", n, heap_sort_ascending(arr, n));
                 } else {
-                    heap_sort_descending(arr, n);
+                    PERF_MEASURE("heap_sort_descending", n, heap_sort_descending(arr, n));
                 }
                 end = clock();
                 cpu_time_used = ((double)(end - start)) / CLOCKS_PER_SEC;
@@ -257,8 +555,8 @@ void heap_sort_demo() {
 }
 
 void priority_queue_demo() {
-    Heap* max_pq = create_heap(MAX_HEAP_SIZE, true);  // Max priority queue
-    Heap* min_pq = create_heap(MAX_HEAP_SIZE, false); // Min priority queue
+    Heap* max_pq = create_heap(INITIAL_HEAP_CAPACITY, true);  // Max priority queue
+    Heap* min_pq = create_heap(INITIAL_HEAP_CAPACITY, false); // Min priority queue
     int choice, data, priority;
     PQElement element;
     
@@ -306,7 +604,7 @@ void priority_queue_demo() {
                 if (insert_heap(max_pq, data, priority)) {
                     printf("Inserted (%d, %d) into Max Priority Queue.\n", data, priority);
                 } else {
-                    printf("Failed to insert! Queue might be full.\n");
+                    printf("Failed to insert! Out of memory.\n");
                 }
                 break;
                 
@@ -327,7 +625,7 @@ void priority_queue_demo() {
                 if (insert_heap(min_pq, data, priority)) {
                     printf("Inserted (%d, %d) into Min Priority Queue.\n", data, priority);
                 } else {
-                    printf("Failed to insert! Queue might be full.\n");
+                    printf("Failed to insert! Out of memory.\n");
                 }
                 break;
                 
@@ -383,11 +681,13 @@ void priority_queue_demo() {
                 
             case 9:
                 max_pq->size = 0;
+                shrink_heap_to_fit(max_pq);
                 printf("Max Priority Queue cleared.\n");
                 break;
                 
             case 10:
                 min_pq->size = 0;
+                shrink_heap_to_fit(min_pq);
                 printf("Min Priority Queue cleared.\n");
                 break;
                 
@@ -404,29 +704,155 @@ void priority_queue_demo() {
 
 // Heap implementation
 Heap* create_heap(int capacity, bool is_max_heap) {
+    return create_heap_dary(capacity, is_max_heap, 2);
+}
+
+Heap* create_heap_dary(int capacity, bool is_max_heap, int arity) {
+    if (arity < 2 || arity > MAX_HEAP_ARITY || capacity < 1) return NULL;
+    
     Heap* heap = (Heap*)malloc(sizeof(Heap));
     if (!heap) return NULL;
     
-    heap->elements = (PQElement*)malloc(capacity * sizeof(PQElement));
-    if (!heap->elements) {
+    heap->storage = NULL;
+    heap->elements = NULL;
+    heap->size = 0;
+    heap->capacity = 0;
+    heap->initial_capacity = capacity;
+    heap->arity = arity;
+    heap->is_max_heap = is_max_heap;
+    heap->growable = true;
+    heap->shrink_on_drain = false;
+    heap->positions = NULL;
+    heap->slot_handles = NULL;
+    heap->free_handles = NULL;
+    heap->free_count = 0;
+    heap->next_handle = 0;
+    
+    if (!resize_heap(heap, capacity)) {
         free(heap);
         return NULL;
     }
     
-    heap->size = 0;
-    heap->capacity = capacity;
-    heap->is_max_heap = is_max_heap;
+    return heap;
+}
+
+Heap* create_indexed_heap(int capacity, bool is_max_heap, int arity) {
+    Heap* heap = create_heap_dary(capacity, is_max_heap, arity);
+    if (!heap) return NULL;
+    
+    if (!resize_handle_maps(heap, heap->capacity)) {
+        free_heap(heap);
+        return NULL;
+    }
     
     return heap;
 }
 
 void free_heap(Heap* heap) {
     if (heap) {
-        free(heap->elements);
+        free(heap->storage);
+        free(heap->positions);
+        free(heap->slot_handles);
+        free(heap->free_handles);
         free(heap);
     }
 }
 
+// Resizes the cache-aligned element array to the given capacity (at least
+// heap->size). The array is grown with realloc rather than malloc plus a
+// copy: large arrays are mmap-backed in glibc, where realloc remaps the
+// pages instead of copying them, so a doubling insert costs page-table
+// work rather than an O(n) memcpy. Small arrays and other allocators may
+// still copy; that worst case is the price of one flat array and is shown
+// by the burst benchmark (reserve_heap avoids it entirely).
+bool resize_heap(Heap* heap, int capacity) {
+    if (capacity < heap->size || capacity < 1) return false;
+    
+    if (heap->positions) {
+        // Handles are numbered below next_handle, so the maps cannot
+        // shrink past it; once the heap is empty numbering restarts
+        if (heap->size == 0) {
+            heap->next_handle = 0;
+            heap->free_count = 0;
+        }
+        if (capacity < heap->next_handle) return false;
+    }
+    
+    // The handle maps must always cover the capacity, so they grow before
+    // the new storage is swapped in and shrink only after
+    if (heap->positions && capacity > heap->capacity && !resize_handle_maps(heap, capacity)) {
+        return false;
+    }
+    
+    // One extra cache line of slack for the alignment shift below
+    size_t line_elements = CACHE_LINE_SIZE / sizeof(PQElement);
+    size_t offset = heap->storage ? (size_t)(heap->elements - heap->storage) : 0;
+    PQElement* storage = (PQElement*)realloc(heap->storage,
+                                             ((size_t)capacity + line_elements) * sizeof(PQElement));
+    if (!storage) return false;
+    
+    uintptr_t first_child = (uintptr_t)(storage + 1);
+    uintptr_t aligned = (first_child + CACHE_LINE_SIZE - 1) & ~(uintptr_t)(CACHE_LINE_SIZE - 1);
+    PQElement* elements = (PQElement*)aligned - 1;
+    
+    // realloc keeps the elements at their old offset; the block may have
+    // moved to a different alignment, which only small arrays pay for
+    if (heap->size > 0 && elements != storage + offset) {
+        memmove(elements, storage + offset, heap->size * sizeof(PQElement));
+    }
+    
+    heap->storage = storage;
+    heap->elements = elements;
+    int old_capacity = heap->capacity;
+    heap->capacity = capacity;
+    
+    // Maps larger than the capacity are harmless, so a failed shrink is ignored
+    if (heap->positions && capacity < old_capacity) {
+        resize_handle_maps(heap, capacity);
+    }
+    
+    return true;
+}
+
+// Reallocates the handle maps of an indexed heap; handles from next_handle
+// up start free. Each map is stored as soon as it is reallocated, so a
+// failure part way leaves every map at least as large as before.
+bool resize_handle_maps(Heap* heap, int capacity) {
+    int* positions = (int*)realloc(heap->positions, capacity * sizeof(int));
+    if (!positions) return false;
+    heap->positions = positions;
+    for (int h = heap->next_handle; h < capacity; h++) {
+        heap->positions[h] = -1;
+    }
+    
+    int* slot_handles = (int*)realloc(heap->slot_handles, capacity * sizeof(int));
+    if (!slot_handles) return false;
+    heap->slot_handles = slot_handles;
+    
+    int* free_handles = (int*)realloc(heap->free_handles, capacity * sizeof(int));
+    if (!free_handles) return false;
+    heap->free_handles = free_handles;
+    
+    return true;
+}
+
+// Grows the heap to hold at least capacity elements without further
+// allocation; never shrinks
+bool reserve_heap(Heap* heap, int capacity) {
+    if (capacity <= heap->capacity) return true;
+    return resize_heap(heap, capacity);
+}
+
+// Releases unused capacity, keeping at least initial_capacity slots
+bool shrink_heap_to_fit(Heap* heap) {
+    int capacity = heap->size > heap->initial_capacity ? heap->size : heap->initial_capacity;
+    if (heap->positions && heap->size > 0 && capacity < heap->next_handle) {
+        capacity = heap->next_handle;
+    }
+    if (capacity >= heap->capacity) return true;
+    return resize_heap(heap, capacity);
+}
+
 bool is_heap_empty(Heap* heap) {
     return heap->size == 0;
 }
@@ -453,157 +879,986 @@ int right_child(int index) {
     return 2 * index + 2;
 }
 
+// True if a priority of a belongs above one of b
+bool has_higher_priority(Heap* heap, int a, int b) {
+    return heap->is_max_heap ? a > b : a < b;
+}
+
+// Sift up by moving a hole: parents that rank below the element slide
+// down one level, and the element is written once where the hole stops
 void heapify_up(Heap* heap, int index) {
-    if (index == 0) return;
-    
-    int parent_idx = parent(index);
-    bool should_swap;
+    PQElement* elements = heap->elements;
+    int* handles = heap->slot_handles;
+    PQElement moving = elements[index];
+    int moving_handle = handles ? handles[index] : -1;
     
-    if (heap->is_max_heap) {
-        should_swap = heap->elements[index].priority > heap->elements[parent_idx].priority;
-    } else {
-        should_swap = heap->elements[index].priority < heap->elements[parent_idx].priority;
+    while (index > 0) {
+        int parent_idx = (index - 1) / heap->arity;
+        if (!has_higher_priority(heap, moving.priority, elements[parent_idx].priority)) {
+            break;
+        }
+        elements[index] = elements[parent_idx];
+        if (handles) set_slot_handle(heap, index, handles[parent_idx]);
+        index = parent_idx;
     }
     
-    if (should_swap) {
-        swap_elements(&heap->elements[index], &heap->elements[parent_idx]);
-        heapify_up(heap, parent_idx);
-    }
+    elements[index] = moving;
+    if (handles) set_slot_handle(heap, index, moving_handle);
 }
 
+// Sift down by moving a hole to the highest-priority child until the
+// element outranks all children. All children of a node are contiguous,
+// so each scan stays within one cache line.
 void heapify_down(Heap* heap, int index) {
-    int left = left_child(index);
-    int right = right_child(index);
-    int target = index;
+    PQElement* elements = heap->elements;
+    int* handles = heap->slot_handles;
+    PQElement moving = elements[index];
+    int moving_handle = handles ? handles[index] : -1;
     
-    if (heap->is_max_heap) {
-        if (left < heap->size && 
-            heap->elements[left].priority > heap->elements[target].priority) {
-            target = left;
-        }
-        if (right < heap->size && 
-            heap->elements[right].priority > heap->elements[target].priority) {
-            target = right;
-        }
-    } else {
-        if (left < heap->size && 
-            heap->elements[left].priority < heap->elements[target].priority) {
-            target = left;
+    while (1) {
+        int first = heap->arity * index + 1;
+        if (first >= heap->size) break;
+        
+        int last = first + heap->arity < heap->size ? first + heap->arity : heap->size;
+        int best = first;
+        for (int child = first + 1; child < last; child++) {
+            if (has_higher_priority(heap, elements[child].priority, elements[best].priority)) {
+                best = child;
+            }
         }
-        if (right < heap->size && 
-            heap->elements[right].priority < heap->elements[target].priority) {
-            target = right;
+        
+        if (!has_higher_priority(heap, elements[best].priority, moving.priority)) {
+            break;
         }
+        elements[index] = elements[best];
+        if (handles) set_slot_handle(heap, index, handles[best]);
+        index = best;
     }
     
-    if (target != index) {
-        swap_elements(&heap->elements[index], &heap->elements[target]);
-        heapify_down(heap, target);
-    }
+    elements[index] = moving;
+    if (handles) set_slot_handle(heap, index, moving_handle);
 }
 
 bool insert_heap(Heap* heap, int data, int priority) {
     if (is_heap_full(heap)) {
-        return false;
+        if (!heap->growable || heap->capacity == INT_MAX) {
+            return false;
+        }
+        int capacity = heap->capacity <= INT_MAX / 2 ? heap->capacity * 2 : INT_MAX;
+        if (!resize_heap(heap, capacity)) {
+            return false;
+        }
     }
     
     heap->elements[heap->size].data = data;
     heap->elements[heap->size].priority = priority;
+    if (heap->slot_handles) {
+        int handle = heap->free_count > 0 ? heap->free_handles[--heap->free_count]
+                                          : heap->next_handle++;
+        set_slot_handle(heap, heap->size, handle);
+    }
     heapify_up(heap, heap->size);
     heap->size++;
     
     return true;
 }
 
-PQElement extract_heap(Heap* heap) {
+// Inserts into an indexed heap and returns the element's handle, or -1 if
+// the heap is not indexed or the insert failed
+int insert_heap_handle(Heap* heap, int data, int priority) {
+    if (!heap->slot_handles) return -1;
+    
+    // insert_heap takes the most recently freed handle, else a new one
+    int handle = heap->free_count > 0 ? heap->free_handles[heap->free_count - 1]
+                                      : heap->next_handle;
+    if (!insert_heap(heap, data, priority)) return -1;
+    
+    return handle;
+}
+
+void set_slot_handle(Heap* heap, int index, int handle) {
+    heap->slot_handles[index] = handle;
+    heap->positions[handle] = index;
+}
+
+// Frees the handle of the element at index for reuse
+void release_handle(Heap* heap, int index) {
+    int handle = heap->slot_handles[index];
+    heap->positions[handle] = -1;
+    heap->free_handles[heap->free_count++] = handle;
+}
+
+bool is_valid_handle(Heap* heap, int handle) {
+    return heap->positions && handle >= 0 && handle < heap->next_handle &&
+           heap->positions[handle] >= 0;
+}
+
+// Sets a new priority and restores order with a single sift toward
+// whichever side the element moved
+bool change_priority(Heap* heap, int handle, int new_priority) {
+    if (!is_valid_handle(heap, handle)) return false;
+    
+    int index = heap->positions[handle];
+    int old_priority = heap->elements[index].priority;
+    heap->elements[index].priority = new_priority;
+    
+    if (has_higher_priority(heap, new_priority, old_priority)) {
+        heapify_up(heap, index);
+    } else {
+        heapify_down(heap, index);
+    }
+    
+    return true;
+}
+
+// Lowers the priority value of a handle; fails if new_priority is larger
+bool decrease_key(Heap* heap, int handle, int new_priority) {
+    if (!is_valid_handle(heap, handle) ||
+        new_priority > heap->elements[heap->positions[handle]].priority) {
+        return false;
+    }
+    return change_priority(heap, handle, new_priority);
+}
+
+// Raises the priority value of a handle; fails if new_priority is smaller
+bool increase_key(Heap* heap, int handle, int new_priority) {
+    if (!is_valid_handle(heap, handle) ||
+        new_priority < heap->elements[heap->positions[handle]].priority) {
+        return false;
+    }
+    return change_priority(heap, handle, new_priority);
+}
+
+// Removes an element by handle: the last element fills its slot and sifts
+// up or down from there. Returns {0, 0} for an invalid handle.
+PQElement remove_heap_handle(Heap* heap, int handle) {
     PQElement result = {0, 0};
     
-    if (is_heap_empty(heap)) {
+    if (!is_valid_handle(heap, handle)) {
         return result;
     }
     
-    result = heap->elements[0];
-    heap->elements[0] = heap->elements[heap->size - 1];
+    int index = heap->positions[handle];
+    result = heap->elements[index];
+    release_handle(heap, index);
     heap->size--;
     
-    if (heap->size > 0) {
-        heapify_down(heap, 0);
+    if (index < heap->size) {
+        heap->elements[index] = heap->elements[heap->size];
+        set_slot_handle(heap, index, heap->slot_handles[heap->size]);
+        
+        if (index > 0 && has_higher_priority(heap, heap->elements[index].priority,
+                                             heap->elements[(index - 1) / heap->arity].priority)) {
+            heapify_up(heap, index);
+        } else {
+            heapify_down(heap, index);
+        }
     }
     
     return result;
 }
 
-PQElement peek_heap(Heap* heap) {
-    PQElement result = {0, 0};
+// Floyd's bottom-up build: replaces the contents of heap with elements
+// in O(n) by sifting down every internal node, deepest first. An indexed
+// heap restarts its handles, giving elements[i] handle i.
+bool build_heap(Heap* heap, PQElement elements[], int n) {
+    if (n < 0) return false;
     
-    if (!is_heap_empty(heap)) {
-        result = heap->elements[0];
+    heap->size = 0;
+    if (n > heap->capacity && (!heap->growable || !resize_heap(heap, n))) {
+        return false;
     }
     
-    return result;
-}
-
-void print_heap(Heap* heap) {
-    if (is_heap_empty(heap)) {
-        printf("Heap is empty.\n");
-        return;
+    memcpy(heap->elements, elements, n * sizeof(PQElement));
+    heap->size = n;
+    
+    if (heap->slot_handles) {
+        heap->next_handle = n;
+        heap->free_count = 0;
+        for (int i = 0; i < n; i++) {
+            set_slot_handle(heap, i, i);
+        }
     }
     
-    printf("Heap (%s): ", heap->is_max_heap ? "Max" : "Min");
-    for (int i = 0; i < heap->size; i++) {
-        printf("(%d,%d) ", heap->elements[i].data, heap->elements[i].priority);
+    for (int i = (n - 2) / heap->arity; n > 1 && i >= 0; i--) {
+        heapify_down(heap, i);
     }
-    printf("\n");
+    
+    return true;
 }
 
-// Heap Sort implementation
-void heap_sort_ascending(int arr[], int n) {
-    // Build max heap
-    for (int i = n / 2 - 1; i >= 0; i--) {
-        heapify_array(arr, n, i);
+// Appends k elements with one capacity check. Small batches sift each
+// element up. From BATCH_HEAPIFY_MIN elements on, the batch is appended
+// unsorted and only its ancestors are re-heapified: the parents of the
+// new slots form one contiguous index range per level, so each level is
+// a run of heapify_down calls over adjacent nodes, and the ranges narrow
+// by the arity on the way up to the root.
+// Indexed heaps are rejected because the caller could not learn the
+// handles; use insert_heap_handle for them.
+bool insert_batch(Heap* heap, const PQElement elements[], int k) {
+    if (heap->slot_handles || k < 0) return false;
+    if (k == 0) return true;
+    
+    if (k > INT_MAX - heap->size) return false;
+    int needed = heap->size + k;
+    if (needed > heap->capacity) {
+        if (!heap->growable) return false;
+        int capacity = heap->capacity <= INT_MAX / 2 ? heap->capacity * 2 : INT_MAX;
+        if (capacity < needed) capacity = needed;
+        if (!resize_heap(heap, capacity)) return false;
     }
     
-    // Extract elements one by one
-    for (int i = n - 1; i > 0; i--) {
-        // Move current root to end
-        int temp = arr[0];
-        arr[0] = arr[i];
-        arr[i] = temp;
+    int first_new = heap->size;
+    memcpy(heap->elements + first_new, elements, k * sizeof(PQElement));
+    heap->size = needed;
+    
+    if (k < BATCH_HEAPIFY_MIN) {
+        for (int i = first_new; i < needed; i++) {
+            heapify_up(heap, i);
+        }
+        return true;
+    }
+    
+    int lo = first_new > 0 ? (first_new - 1) / heap->arity : 0;
+    int hi = (needed - 2) / heap->arity;
+    while (1) {
+        for (int i = hi; i >= lo; i--) {
+            heapify_down(heap, i);
+        }
+        if (lo == 0) break;
         
-        // Call heapify on the reduced heap
-        heapify_array(arr, i, 0);
+        // Parents from lo up were already sifted, after their children
+        int next_hi = (hi - 1) / heap->arity;
+        hi = next_hi < lo - 1 ? next_hi : lo - 1;
+        lo = (lo - 1) / heap->arity;
     }
+    
+    return true;
 }
 
-void heap_sort_descending(int arr[], int n) {
-    // Build min heap
-    for (int i = n / 2 - 1; i >= 0; i--) {
-        // Use modified heapify for min heap
-        int smallest = i;
-        int left = 2 * i + 1;
-        int right = 2 * i + 2;
-        
-        if (left < n && arr[left] < arr[smallest]) {
-            smallest = left;
+// Removes up to k elements in priority order into out and returns how
+// many were removed. The extract strategy is chosen once for the batch
+// and the drain check runs once at the end.
+int extract_top_k(Heap* heap, PQElement out[], int k) {
+    int count = k < heap->size ? k : heap->size;
+    if (count <= 0) return 0;
+    
+    if (heap->size > BOTTOM_UP_EXTRACT_LIMIT) {
+        // Top-down until the heap falls back under the limit
+        int i = 0;
+        for (; i < count && heap->size > BOTTOM_UP_EXTRACT_LIMIT; i++) {
+            out[i] = extract_heap_top_down(heap);
         }
-        
-        if (right < n && arr[right] < arr[smallest]) {
-            smallest = right;
+        for (; i < count; i++) {
+            out[i] = extract_heap_bottom_up(heap);
         }
-        
-        if (smallest != i) {
-            int temp = arr[i];
-            arr[i] = arr[smallest];
-            arr[smallest] = temp;
-            
-            // Recursively heapify the affected subtree
-            for (int j = smallest; j < n; ) {
-                int min_idx = j;
-                int l = 2 * j + 1;
-                int r = 2 * j + 2;
-                
-                if (l < n && arr[l] < arr[min_idx]) {
-                    min_idx = l;
+    } else {
+        for (int i = 0; i < count; i++) {
+            out[i] = extract_heap_bottom_up(heap);
+        }
+    }
+    
+    if (heap->size == 0 && heap->shrink_on_drain && heap->capacity > heap->initial_capacity) {
+        resize_heap(heap, heap->initial_capacity);
+    }
+    
+    return count;
+}
+
+// Removes the root. Floyd's bottom-up extract saves comparisons while the
+// heap is cache-resident; beyond BOTTOM_UP_EXTRACT_LIMIT elements its
+// walk to the cold leaf level costs more than it saves (measured with
+// benchmark_sift_strategies), so larger heaps sift top-down.
+PQElement extract_heap(Heap* heap) {
+    PQElement result;
+    
+    if (heap->size > BOTTOM_UP_EXTRACT_LIMIT) {
+        result = extract_heap_top_down(heap);
+    } else {
+        result = extract_heap_bottom_up(heap);
+    }
+    
+    // An empty heap has nothing to copy, so releasing memory here is O(1)
+    if (heap->size == 0 && heap->shrink_on_drain && heap->capacity > heap->initial_capacity) {
+        resize_heap(heap, heap->initial_capacity);
+    }
+    
+    return result;
+}
+
+// Floyd's bottom-up extract: the hole left by the root is walked down to
+// a leaf along the highest-priority children without comparing against
+// the displaced last element, which is then sifted up from that leaf.
+// The last element usually belongs near the bottom, so this saves about
+// one comparison per level over the top-down sift.
+PQElement extract_heap_bottom_up(Heap* heap) {
+    PQElement result = {0, 0};
+    
+    if (is_heap_empty(heap)) {
+        return result;
+    }
+    
+    PQElement* elements = heap->elements;
+    int* handles = heap->slot_handles;
+    result = elements[0];
+    if (handles) release_handle(heap, 0);
+    heap->size--;
+    
+    if (heap->size == 0) {
+        return result;
+    }
+    
+    int hole = 0;
+    while (1) {
+        int first = heap->arity * hole + 1;
+        if (first >= heap->size) break;
+        
+        int last = first + heap->arity < heap->size ? first + heap->arity : heap->size;
+        int best = first;
+        for (int child = first + 1; child < last; child++) {
+            if (has_higher_priority(heap, elements[child].priority, elements[best].priority)) {
+                best = child;
+            }
+        }
+        
+        elements[hole] = elements[best];
+        if (handles) set_slot_handle(heap, hole, handles[best]);
+        hole = best;
+    }
+    
+    elements[hole] = elements[heap->size];
+    if (handles) set_slot_handle(heap, hole, handles[heap->size]);
+    heapify_up(heap, hole);
+    
+    return result;
+}
+
+// Top-down extract: the last element moves to the root and sifts down
+PQElement extract_heap_top_down(Heap* heap) {
+    PQElement result = {0, 0};
+    
+    if (is_heap_empty(heap)) {
+        return result;
+    }
+    
+    result = heap->elements[0];
+    heap->elements[0] = heap->elements[heap->size - 1];
+    if (heap->slot_handles) {
+        release_handle(heap, 0);
+        if (heap->size > 1) set_slot_handle(heap, 0, heap->slot_handles[heap->size - 1]);
+    }
+    heap->size--;
+    
+    if (heap->size > 0) {
+        heapify_down(heap, 0);
+    }
+    
+    return result;
+}
+
+// The original recursive, swap-per-level sifts, kept as the baseline for
+// benchmark_sift_strategies. They do not maintain handles, so they must
+// not be used on indexed heaps.
+void heapify_up_recursive(Heap* heap, int index) {
+    if (index == 0) return;
+    
+    int parent_idx = (index - 1) / heap->arity;
+    
+    if (has_higher_priority(heap, heap->elements[index].priority,
+                            heap->elements[parent_idx].priority)) {
+        swap_elements(&heap->elements[index], &heap->elements[parent_idx]);
+        heapify_up_recursive(heap, parent_idx);
+    }
+}
+
+void heapify_down_recursive(Heap* heap, int index) {
+    int first = heap->arity * index + 1;
+    int last = first + heap->arity;
+    int target = index;
+    
+    if (last > heap->size) {
+        last = heap->size;
+    }
+    
+    for (int child = first; child < last; child++) {
+        if (has_higher_priority(heap, heap->elements[child].priority,
+                                heap->elements[target].priority)) {
+            target = child;
+        }
+    }
+    
+    if (target != index) {
+        swap_elements(&heap->elements[index], &heap->elements[target]);
+        heapify_down_recursive(heap, target);
+    }
+}
+
+PQElement peek_heap(Heap* heap) {
+    PQElement result = {0, 0};
+    
+    if (!is_heap_empty(heap)) {
+        result = heap->elements[0];
+    }
+    
+    return result;
+}
+
+void print_heap(Heap* heap) {
+    if (is_heap_empty(heap)) {
+        printf("Heap is empty.\n");
+        return;
+    }
+    
+    printf("Heap (%s, %d/%d): ", heap->is_max_heap ? "Max" : "Min", heap->size, heap->capacity);
+    for (int i = 0; i < heap->size; i++) {
+        printf("(%d,%d) ", heap->elements[i].data, heap->elements[i].priority);
+    }
+    printf("\n");
+}
+
+// Pairing heap implementation
+PairingHeap* create_pairing_heap(bool is_max_heap) {
+    PairingHeap* heap = (PairingHeap*)malloc(sizeof(PairingHeap));
+    if (!heap) return NULL;
+    
+    heap->root = NULL;
+    heap->size = 0;
+    heap->is_max_heap = is_max_heap;
+    
+    return heap;
+}
+
+void free_pairing_heap(PairingHeap* heap) {
+    if (!heap) return;
+    
+    // Splice each child list into the sibling chain so the walk is
+    // iterative and deep trees cannot overflow the stack
+    PairingNode* node = heap->root;
+    while (node) {
+        if (node->child) {
+            PairingNode* tail = node->child;
+            while (tail->sibling) tail = tail->sibling;
+            tail->sibling = node->sibling;
+            node->sibling = node->child;
+        }
+        PairingNode* next = node->sibling;
+        free(node);
+        node = next;
+    }
+    
+    free(heap);
+}
+
+// Makes the root that ranks lower the first child of the other
+PairingNode* pairing_link(PairingHeap* heap, PairingNode* a, PairingNode* b) {
+    if (!a) return b;
+    if (!b) return a;
+    
+    bool b_first = heap->is_max_heap ? b->element.priority > a->element.priority
+                                     : b->element.priority < a->element.priority;
+    if (b_first) {
+        PairingNode* temp = a;
+        a = b;
+        b = temp;
+    }
+    
+    b->sibling = a->child;
+    a->child = b;
+    a->sibling = NULL;
+    
+    return a;
+}
+
+bool pairing_heap_insert(PairingHeap* heap, int data, int priority) {
+    PairingNode* node = (PairingNode*)malloc(sizeof(PairingNode));
+    if (!node) return false;
+    
+    node->element.data = data;
+    node->element.priority = priority;
+    node->child = NULL;
+    node->sibling = NULL;
+    
+    heap->root = pairing_link(heap, heap->root, node);
+    heap->size++;
+    
+    return true;
+}
+
+// Moves every node of other into heap in O(1); other is left empty.
+// Both heaps must have the same ordering.
+void pairing_heap_meld(PairingHeap* heap, PairingHeap* other) {
+    heap->root = pairing_link(heap, heap->root, other->root);
+    heap->size += other->size;
+    other->root = NULL;
+    other->size = 0;
+}
+
+// Two-pass extract: link the root's children in pairs left to right,
+// then fold the pairs together right to left. The first pass reverses
+// the list as it goes so the second pass is a simple forward walk.
+PQElement pairing_heap_extract(PairingHeap* heap) {
+    PQElement result = {0, 0};
+    
+    if (!heap->root) {
+        return result;
+    }
+    
+    PairingNode* old_root = heap->root;
+    result = old_root->element;
+    
+    PairingNode* pairs = NULL;
+    PairingNode* node = old_root->child;
+    while (node) {
+        PairingNode* first = node;
+        PairingNode* second = node->sibling;
+        node = second ? second->sibling : NULL;
+        
+        first->sibling = NULL;
+        if (second) second->sibling = NULL;
+        
+        PairingNode* linked = pairing_link(heap, first, second);
+        linked->sibling = pairs;
+        pairs = linked;
+    }
+    
+    PairingNode* root = NULL;
+    while (pairs) {
+        PairingNode* next = pairs->sibling;
+        pairs->sibling = NULL;
+        root = pairing_link(heap, root, pairs);
+        pairs = next;
+    }
+    
+    heap->root = root;
+    heap->size--;
+    free(old_root);
+    
+    return result;
+}
+
+// Radix heap implementation
+RadixHeap* create_radix_heap() {
+    RadixHeap* heap = (RadixHeap*)calloc(1, sizeof(RadixHeap));
+    return heap;
+}
+
+void free_radix_heap(RadixHeap* heap) {
+    if (!heap) return;
+    
+    for (int i = 0; i < RADIX_HEAP_BUCKETS; i++) {
+        free(heap->buckets[i].items);
+    }
+    free(heap);
+}
+
+// Maps int order onto unsigned order so INT_MIN becomes 0
+unsigned int radix_key(int priority) {
+    return (unsigned int)priority ^ 0x80000000u;
+}
+
+int radix_bucket_index(unsigned int key, unsigned int last) {
+    return key == last ? 0 : 32 - __builtin_clz(key ^ last);
+}
+
+bool radix_bucket_push(RadixBucket* bucket, PQElement element) {
+    if (bucket->size == bucket->capacity) {
+        int capacity = bucket->capacity ? bucket->capacity * 2 : INITIAL_HEAP_CAPACITY;
+        PQElement* items = (PQElement*)realloc(bucket->items, capacity * sizeof(PQElement));
+        if (!items) return false;
+        bucket->items = items;
+        bucket->capacity = capacity;
+    }
+    
+    bucket->items[bucket->size++] = element;
+    return true;
+}
+
+// Fails if priority is below the last extracted priority. Once the heap
+// is empty the bound resets, so it can be refilled with any keys.
+bool radix_heap_insert(RadixHeap* heap, int data, int priority) {
+    unsigned int key = radix_key(priority);
+    if (heap->size == 0) heap->last = 0;
+    if (key < heap->last) return false;
+    
+    PQElement element = {data, priority};
+    if (!radix_bucket_push(&heap->buckets[radix_bucket_index(key, heap->last)], element)) {
+        return false;
+    }
+    heap->size++;
+    
+    return true;
+}
+
+// Makes bucket 0 non-empty: the lowest non-empty bucket's minimum becomes
+// last and the whole bucket redistributes into lower buckets. Target
+// buckets are grown before anything moves, so on allocation failure the
+// heap is left unchanged and false is returned.
+bool radix_heap_refill(RadixHeap* heap) {
+    if (heap->buckets[0].size > 0) return true;
+    
+    int i = 1;
+    while (heap->buckets[i].size == 0) i++;
+    
+    RadixBucket* bucket = &heap->buckets[i];
+    unsigned int min_key = radix_key(bucket->items[0].priority);
+    for (int j = 1; j < bucket->size; j++) {
+        unsigned int key = radix_key(bucket->items[j].priority);
+        if (key < min_key) min_key = key;
+    }
+    
+    int counts[RADIX_HEAP_BUCKETS] = {0};
+    for (int j = 0; j < bucket->size; j++) {
+        counts[radix_bucket_index(radix_key(bucket->items[j].priority), min_key)]++;
+    }
+    
+    // Every key lands in a bucket below i, so bucket i is never appended
+    // to while it drains
+    for (int b = 0; b < i; b++) {
+        RadixBucket* target = &heap->buckets[b];
+        if (target->size + counts[b] > target->capacity) {
+            int capacity = target->size + counts[b];
+            PQElement* items = (PQElement*)realloc(target->items, capacity * sizeof(PQElement));
+            if (!items) return false;
+            target->items = items;
+            target->capacity = capacity;
+        }
+    }
+    
+    heap->last = min_key;
+    for (int j = 0; j < bucket->size; j++) {
+        PQElement element = bucket->items[j];
+        RadixBucket* target = &heap->buckets[radix_bucket_index(radix_key(element.priority), min_key)];
+        target->items[target->size++] = element;
+    }
+    bucket->size = 0;
+    
+    return true;
+}
+
+// Returns false if the heap is empty or redistributing runs out of memory;
+// in the latter case the heap is unchanged and the call can be retried
+bool radix_heap_extract(RadixHeap* heap, PQElement* out) {
+    if (heap->size == 0 || !radix_heap_refill(heap)) {
+        return false;
+    }
+    
+    *out = heap->buckets[0].items[--heap->buckets[0].size];
+    heap->size--;
+    
+    return true;
+}
+
+bool radix_heap_peek(RadixHeap* heap, PQElement* out) {
+    if (heap->size == 0 || !radix_heap_refill(heap)) {
+        return false;
+    }
+    
+    *out = heap->buckets[0].items[heap->buckets[0].size - 1];
+    return true;
+}
+
+// Engine-independent priority queue interface
+PriorityQueue* pq_create(PQEngine engine, bool is_max_heap) {
+    // The radix heap relies on keys never going below the last minimum
+    if (engine == PQ_ENGINE_RADIX && is_max_heap) return NULL;
+    
+    PriorityQueue* pq = (PriorityQueue*)malloc(sizeof(PriorityQueue));
+    if (!pq) return NULL;
+    
+    pq->engine = engine;
+    switch (engine) {
+        case PQ_ENGINE_BINARY:
+            pq->impl.heap = create_heap(INITIAL_HEAP_CAPACITY, is_max_heap);
+            break;
+        case PQ_ENGINE_DARY:
+            pq->impl.heap = create_heap_dary(INITIAL_HEAP_CAPACITY, is_max_heap, 4);
+            break;
+        case PQ_ENGINE_PAIRING:
+            pq->impl.pairing = create_pairing_heap(is_max_heap);
+            break;
+        case PQ_ENGINE_RADIX:
+            pq->impl.radix = create_radix_heap();
+            break;
+        default:
+            pq->impl.heap = NULL;
+    }
+    
+    // All union members are pointers, so any one reports allocation failure
+    if (!pq->impl.heap) {
+        free(pq);
+        return NULL;
+    }
+    
+    return pq;
+}
+
+void pq_free(PriorityQueue* pq) {
+    if (!pq) return;
+    
+    switch (pq->engine) {
+        case PQ_ENGINE_PAIRING:
+            free_pairing_heap(pq->impl.pairing);
+            break;
+        case PQ_ENGINE_RADIX:
+            free_radix_heap(pq->impl.radix);
+            break;
+        default:
+            free_heap(pq->impl.heap);
+    }
+    free(pq);
+}
+
+bool pq_insert(PriorityQueue* pq, int data, int priority) {
+    switch (pq->engine) {
+        case PQ_ENGINE_PAIRING:
+            return pairing_heap_insert(pq->impl.pairing, data, priority);
+        case PQ_ENGINE_RADIX:
+            return radix_heap_insert(pq->impl.radix, data, priority);
+        default:
+            return insert_heap(pq->impl.heap, data, priority);
+    }
+}
+
+// Returns false if the queue is empty or, for the radix heap, if the
+// extract could not allocate; the queue is unchanged in both cases
+bool pq_extract(PriorityQueue* pq, PQElement* out) {
+    switch (pq->engine) {
+        case PQ_ENGINE_PAIRING:
+            if (!pq->impl.pairing->root) return false;
+            *out = pairing_heap_extract(pq->impl.pairing);
+            return true;
+        case PQ_ENGINE_RADIX:
+            return radix_heap_extract(pq->impl.radix, out);
+        default:
+            if (pq->impl.heap->size == 0) return false;
+            *out = extract_heap(pq->impl.heap);
+            return true;
+    }
+}
+
+bool pq_peek(PriorityQueue* pq, PQElement* out) {
+    switch (pq->engine) {
+        case PQ_ENGINE_PAIRING:
+            if (!pq->impl.pairing->root) return false;
+            *out = pq->impl.pairing->root->element;
+            return true;
+        case PQ_ENGINE_RADIX:
+            return radix_heap_peek(pq->impl.radix, out);
+        default:
+            if (pq->impl.heap->size == 0) return false;
+            *out = peek_heap(pq->impl.heap);
+            return true;
+    }
+}
+
+int pq_size(PriorityQueue* pq) {
+    switch (pq->engine) {
+        case PQ_ENGINE_PAIRING:
+            return pq->impl.pairing->size;
+        case PQ_ENGINE_RADIX:
+            return pq->impl.radix->size;
+        default:
+            return pq->impl.heap->size;
+    }
+}
+
+bool pq_is_empty(PriorityQueue* pq) {
+    return pq_size(pq) == 0;
+}
+
+const char* pq_engine_name(PQEngine engine) {
+    switch (engine) {
+        case PQ_ENGINE_BINARY: return "Binary heap";
+        case PQ_ENGINE_DARY: return "4-ary heap";
+        case PQ_ENGINE_PAIRING: return "Pairing heap";
+        case PQ_ENGINE_RADIX: return "Radix heap";
+        default: return "Unknown";
+    }
+}
+
+// MultiQueue implementation
+MultiQueue* create_multiqueue(int num_shards, bool is_max_heap) {
+    if (num_shards < 1) return NULL;
+    
+    MultiQueue* mq = (MultiQueue*)malloc(sizeof(MultiQueue));
+    if (!mq) return NULL;
+    
+    mq->storage = malloc(num_shards * sizeof(MultiQueueShard) + CACHE_LINE_SIZE);
+    if (!mq->storage) {
+        free(mq);
+        return NULL;
+    }
+    
+    uintptr_t base = ((uintptr_t)mq->storage + CACHE_LINE_SIZE - 1) & ~(uintptr_t)(CACHE_LINE_SIZE - 1);
+    mq->shards = (MultiQueueShard*)base;
+    mq->num_shards = num_shards;
+    mq->is_max_heap = is_max_heap;
+    
+    for (int i = 0; i < num_shards; i++) {
+        MultiQueueShard* shard = &mq->shards[i];
+        shard->heap = create_heap_dary(INITIAL_HEAP_CAPACITY, is_max_heap, 4);
+        if (!shard->heap || pthread_mutex_init(&shard->lock, NULL) != 0) {
+            free_heap(shard->heap);
+            mq->num_shards = i;
+            free_multiqueue(mq);
+            return NULL;
+        }
+        shard->top = 0;
+        shard->size = 0;
+    }
+    
+    return mq;
+}
+
+void free_multiqueue(MultiQueue* mq) {
+    if (!mq) return;
+    
+    for (int i = 0; i < mq->num_shards; i++) {
+        pthread_mutex_destroy(&mq->shards[i].lock);
+        free_heap(mq->shards[i].heap);
+    }
+    free(mq->storage);
+    free(mq);
+}
+
+// xorshift32: callers keep one nonzero state per thread, since rand()
+// shares hidden state across threads
+unsigned int mq_random(unsigned int* state) {
+    unsigned int x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+// Publishes the shard's top and size for lock-free sampling; call with
+// the shard locked
+void mq_update_cache(MultiQueueShard* shard) {
+    int size = shard->heap->size;
+    __atomic_store_n(&shard->top, size > 0 ? shard->heap->elements[0].priority : 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&shard->size, size, __ATOMIC_RELAXED);
+}
+
+// Inserts into a random shard, skipping locked ones; after num_shards
+// busy tries it waits on the last shard picked
+bool mq_insert(MultiQueue* mq, unsigned int* rng, int data, int priority) {
+    MultiQueueShard* shard = NULL;
+    
+    for (int attempt = 0; ; attempt++) {
+        shard = &mq->shards[mq_random(rng) % mq->num_shards];
+        if (pthread_mutex_trylock(&shard->lock) == 0) break;
+        if (attempt >= mq->num_shards) {
+            pthread_mutex_lock(&shard->lock);
+            break;
+        }
+    }
+    
+    bool ok = insert_heap(shard->heap, data, priority);
+    mq_update_cache(shard);
+    pthread_mutex_unlock(&shard->lock);
+    
+    return ok;
+}
+
+// Extracts from the better of two random shards. The cached tops may be
+// stale, which only affects which shard is chosen: the element itself is
+// taken under the shard lock. Returns false if every shard was empty.
+bool mq_extract(MultiQueue* mq, unsigned int* rng, PQElement* out) {
+    for (int attempt = 0; attempt < 2 * mq->num_shards; attempt++) {
+        MultiQueueShard* a = &mq->shards[mq_random(rng) % mq->num_shards];
+        MultiQueueShard* b = &mq->shards[mq_random(rng) % mq->num_shards];
+        int a_size = __atomic_load_n(&a->size, __ATOMIC_RELAXED);
+        int b_size = __atomic_load_n(&b->size, __ATOMIC_RELAXED);
+        
+        if (a_size == 0 && b_size == 0) continue;
+        
+        MultiQueueShard* shard = a;
+        if (a_size == 0) {
+            shard = b;
+        } else if (b_size > 0) {
+            int a_top = __atomic_load_n(&a->top, __ATOMIC_RELAXED);
+            int b_top = __atomic_load_n(&b->top, __ATOMIC_RELAXED);
+            if (mq->is_max_heap ? b_top > a_top : b_top < a_top) shard = b;
+        }
+        
+        if (pthread_mutex_trylock(&shard->lock) != 0) continue;
+        if (shard->heap->size > 0) {
+            *out = extract_heap(shard->heap);
+            mq_update_cache(shard);
+            pthread_mutex_unlock(&shard->lock);
+            return true;
+        }
+        pthread_mutex_unlock(&shard->lock);
+    }
+    
+    // Sampling kept missing: sweep every shard before reporting empty
+    for (int i = 0; i < mq->num_shards; i++) {
+        MultiQueueShard* shard = &mq->shards[i];
+        pthread_mutex_lock(&shard->lock);
+        if (shard->heap->size > 0) {
+            *out = extract_heap(shard->heap);
+            mq_update_cache(shard);
+            pthread_mutex_unlock(&shard->lock);
+            return true;
+        }
+        pthread_mutex_unlock(&shard->lock);
+    }
+    
+    return false;
+}
+
+// Heap Sort implementation
+void heap_sort_ascending(int arr[], int n) {
+    heap_sort_ascending_parallel(arr, n, 1);
+}
+
+// Heap sort with the build phase spread over num_threads threads (0 = all
+// online CPUs); the extraction phase is inherently sequential
+void heap_sort_ascending_parallel(int arr[], int n, int num_threads) {
+    build_max_heap_parallel(arr, n, num_threads);
+    
+    // Extract elements one by one
+    for (int i = n - 1; i > 0; i--) {
+        // Move current root to end
+        int temp = arr[0];
+        arr[0] = arr[i];
+        arr[i] = temp;
+        
+        // Call heapify on the reduced heap
+        heapify_array(arr, i, 0);
+    }
+}
+
+void heap_sort_descending(int arr[], int n) {
+    // Build min heap
+    for (int i = n / 2 - 1; i >= 0; i--) {
+        // Use modified heapify for min heap
+        int smallest = i;
+        int left = 2 * i + 1;
+        int right = 2 * i + 2;
+        
+        if (left < n && arr[left] < arr[smallest]) {
+            smallest = left;
+        }
+        
+        if (right < n && arr[right] < arr[smallest]) {
+            smallest = right;
+        }
+        
+        if (smallest != i) {
+            int temp = arr[i];
+            arr[i] = arr[smallest];
+            arr[smallest] = temp;
+            
+            // Recursively heapify the affected subtree
+            for (int j = smallest; j < n; ) {
+                int min_idx = j;
+                int l = 2 * j + 1;
+                int r = 2 * j + 2;
+                
+                if (l < n && arr[l] < arr[min_idx]) {
+                    min_idx = l;
                 }
                 
                 if (r < n && arr[r] < arr[min_idx]) {
@@ -655,6 +1910,77 @@ void heap_sort_descending(int arr[], int n) {
     }
 }
 
+// Floyd's build with independent subtrees in parallel. The split level S
+// is the first with at least 4 nodes per thread; each thread takes a
+// contiguous block of level-S roots and heapifies their subtrees level by
+// level from the bottom. A block's descendants on every level form one
+// contiguous index range, so each thread sweeps its own part of the
+// array. The 2^S - 1 nodes above the split are finished sequentially.
+void build_max_heap_parallel(int arr[], int n, int num_threads) {
+    if (num_threads <= 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        num_threads = cpus < 1 ? 1 : (int)cpus;
+    }
+    if (num_threads > MAX_BUILD_THREADS) num_threads = MAX_BUILD_THREADS;
+    
+    if (num_threads == 1 || n < PARALLEL_HEAP_BUILD_CUTOFF) {
+        for (int i = n / 2 - 1; i >= 0; i--) {
+            heapify_array(arr, n, i);
+        }
+        return;
+    }
+    
+    int level = 0;
+    while ((1 << level) < 4 * num_threads) level++;
+    int level_first = (1 << level) - 1;
+    int level_width = 1 << level;
+    
+    pthread_t threads[MAX_BUILD_THREADS];
+    HeapBuildArgs args[MAX_BUILD_THREADS];
+    bool started[MAX_BUILD_THREADS];
+    
+    for (int t = 0; t < num_threads; t++) {
+        args[t].arr = arr;
+        args[t].n = n;
+        args[t].first_root = level_first + (int)((long long)level_width * t / num_threads);
+        args[t].last_root = level_first + (int)((long long)level_width * (t + 1) / num_threads) - 1;
+        started[t] = pthread_create(&threads[t], NULL, heap_build_worker, &args[t]) == 0;
+        if (!started[t]) {
+            heap_build_worker(&args[t]);
+        }
+    }
+    
+    for (int t = 0; t < num_threads; t++) {
+        if (started[t]) pthread_join(threads[t], NULL);
+    }
+    
+    for (int i = level_first - 1; i >= 0; i--) {
+        heapify_array(arr, n, i);
+    }
+}
+
+void* heap_build_worker(void* arg) {
+    HeapBuildArgs* args = (HeapBuildArgs*)arg;
+    long long last_internal = args->n / 2 - 1;
+    
+    // Descendants at depth d below roots first..last are the indices
+    // (first + 1) * 2^d - 1 .. (last + 2) * 2^d - 2
+    int depth = 0;
+    while (((long long)(args->first_root + 1) << (depth + 1)) - 1 <= last_internal) depth++;
+    
+    for (; depth >= 0; depth--) {
+        long long lo = ((long long)(args->first_root + 1) << depth) - 1;
+        long long hi = ((long long)(args->last_root + 2) << depth) - 2;
+        if (hi > last_internal) hi = last_internal;
+        
+        for (long long i = hi; i >= lo; i--) {
+            heapify_array(args->arr, args->n, (int)i);
+        }
+    }
+    
+    return NULL;
+}
+
 void heapify_array(int arr[], int n, int root) {
     int largest = root;
     int left = 2 * root + 1;
@@ -685,7 +2011,6 @@ void print_array(int arr[], int n) {
 }
 
 void generate_random_array(int arr[], int n, int max_value) {
-    srand(time(NULL));
     for (int i = 0; i < n; i++) {
         arr[i] = rand() % max_value;
     }
@@ -707,4 +2032,667 @@ bool is_sorted_descending(int arr[], int n) {
         }
     }
     return true;
-}
\ No newline at end of file
+}
+
+// Inserts then extracts n random priorities with 2-, 4- and 8-ary
+// layouts, for n = 1M, 10M, ... up to max_size
+void benchmark_heap_arity(int max_size) {
+    int arities[] = {2, 4, 8};
+    int num_arities = sizeof(arities) / sizeof(arities[0]);
+    
+    printf("\n=== d-ary Heap Layout Benchmark (min-heap, random priorities) ===\n");
+    printf("%-12s %-6s %-12s %-12s %-12s %s\n",
+           "Size", "Arity", "Insert (s)", "Extract (s)", "Total (s)", "Ordered");
+    
+    for (int n = 1000000; n > 0 && n <= max_size; n = n <= max_size / 10 ? n * 10 : 0) {
+        int* priorities = (int*)malloc(n * sizeof(int));
+        if (!priorities) {
+            printf("Memory allocation failed for size %d\n", n);
+            break;
+        }
+        
+        for (int i = 0; i < n; i++) {
+            priorities[i] = (int)(((unsigned int)rand() << 16) ^ (unsigned int)rand());
+        }
+        
+        for (int a = 0; a < num_arities; a++) {
+            Heap* heap = create_heap_dary(n, false, arities[a]);
+            if (!heap) {
+                printf("Memory allocation failed for size %d\n", n);
+                break;
+            }
+            
+            clock_t start = clock();
+            for (int i = 0; i < n; i++) {
+                insert_heap(heap, i, priorities[i]);
+            }
+            double insert_time = ((double)(clock() - start)) / CLOCKS_PER_SEC;
+            
+            bool ordered = true;
+            int previous = 0;
+            start = clock();
+            for (int i = 0; i < n; i++) {
+                int priority = extract_heap(heap).priority;
+                if (i > 0 && priority < previous) ordered = false;
+                previous = priority;
+            }
+            double extract_time = ((double)(clock() - start)) / CLOCKS_PER_SEC;
+            
+            printf("%-12d %-6d %-12.4f %-12.4f %-12.4f %s\n", n, arities[a], insert_time,
+                   extract_time, insert_time + extract_time, ordered ? "Yes" : "No");
+            free_heap(heap);
+        }
+        
+        free(priorities);
+    }
+}
+
+// Fills a heap with n random priorities and drains it using the
+// recursive swap sifts, the iterative hole sifts with top-down extract,
+// the hole sifts with Floyd's bottom-up extract, and extract_heap's
+// size-based choice between the last two
+void benchmark_sift_strategies(int n) {
+    const char* strategy_names[] = {"Recursive swaps", "Hole, top-down", "Hole, bottom-up",
+                                    "extract_heap"};
+    int arities[] = {2, 4};
+    
+    int* priorities = (int*)malloc(n * sizeof(int));
+    if (!priorities) {
+        printf("Memory allocation failed!\n");
+        return;
+    }
+    for (int i = 0; i < n; i++) {
+        priorities[i] = (int)(((unsigned int)rand() << 16) ^ (unsigned int)rand());
+    }
+    
+    printf("\n=== Sift Strategy Microbenchmark (%d elements, min-heap) ===\n", n);
+    printf("%-6s %-18s %-12s %-12s %s\n", "Arity", "Strategy", "Insert (s)", "Extract (s)", "Ordered");
+    
+    for (int a = 0; a < 2; a++) {
+        for (int strategy = 0; strategy < 4; strategy++) {
+            Heap* heap = create_heap_dary(n, false, arities[a]);
+            if (!heap) {
+                printf("Memory allocation failed!\n");
+                free(priorities);
+                return;
+            }
+            
+            clock_t start = clock();
+            for (int i = 0; i < n; i++) {
+                heap->elements[heap->size].data = i;
+                heap->elements[heap->size].priority = priorities[i];
+                if (strategy == 0) {
+                    heapify_up_recursive(heap, heap->size);
+                } else {
+                    heapify_up(heap, heap->size);
+                }
+                heap->size++;
+            }
+            double insert_time = ((double)(clock() - start)) / CLOCKS_PER_SEC;
+            
+            bool ordered = true;
+            int previous = 0;
+            start = clock();
+            for (int i = 0; i < n; i++) {
+                PQElement top;
+                if (strategy == 0) {
+                    top = heap->elements[0];
+                    heap->elements[0] = heap->elements[--heap->size];
+                    heapify_down_recursive(heap, 0);
+                } else if (strategy == 1) {
+                    top = extract_heap_top_down(heap);
+                } else if (strategy == 2) {
+                    top = extract_heap_bottom_up(heap);
+                } else {
+                    top = extract_heap(heap);
+                }
+                if (i > 0 && top.priority < previous) ordered = false;
+                previous = top.priority;
+            }
+            double extract_time = ((double)(clock() - start)) / CLOCKS_PER_SEC;
+            
+            printf("%-6d %-18s %-12.4f %-12.4f %s\n", arities[a], strategy_names[strategy],
+                   insert_time, extract_time, ordered ? "Yes" : "No");
+            free_heap(heap);
+        }
+    }
+    
+    free(priorities);
+}
+
+// Times a burst of n inserts followed by a full drain: growing from
+// INITIAL_HEAP_CAPACITY, growing with shrink-on-drain, and with the
+// capacity reserved up front. Worst single-operation times show that
+// resizing cost lands on inserts only.
+void benchmark_heap_growth(int n) {
+    const char* mode_names[] = {"Grow from 16", "Grow + shrink", "Reserved"};
+    
+    printf("\n=== Growable Queue Burst (%d inserts, then drain) ===\n", n);
+    printf("%-14s %-11s %-11s %-15s %-15s %s\n", "Mode", "Insert (s)", "Extract (s)",
+           "Max insert (s)", "Max extract (s)", "Final capacity");
+    
+    for (int mode = 0; mode < 3; mode++) {
+        Heap* heap = create_heap(INITIAL_HEAP_CAPACITY, false);
+        if (!heap || (mode == 2 && !reserve_heap(heap, n))) {
+            printf("Memory allocation failed!\n");
+            free_heap(heap);
+            return;
+        }
+        heap->shrink_on_drain = mode == 1;
+        
+        double max_insert = 0, max_extract = 0;
+        bool ok = true;
+        
+        clock_t burst_start = clock();
+        for (int i = 0; i < n && ok; i++) {
+            clock_t op_start = clock();
+            ok = insert_heap(heap, i, rand());
+            double elapsed = ((double)(clock() - op_start)) / CLOCKS_PER_SEC;
+            if (elapsed > max_insert) max_insert = elapsed;
+        }
+        double insert_time = ((double)(clock() - burst_start)) / CLOCKS_PER_SEC;
+        
+        burst_start = clock();
+        while (!is_heap_empty(heap)) {
+            clock_t op_start = clock();
+            extract_heap(heap);
+            double elapsed = ((double)(clock() - op_start)) / CLOCKS_PER_SEC;
+            if (elapsed > max_extract) max_extract = elapsed;
+        }
+        double extract_time = ((double)(clock() - burst_start)) / CLOCKS_PER_SEC;
+        
+        if (!ok) {
+            printf("%-14s insert failed (out of memory)\n", mode_names[mode]);
+        } else {
+            printf("%-14s %-11.4f %-11.4f %-15.6f %-15.6f %d\n", mode_names[mode], insert_time,
+                   extract_time, max_insert, max_extract, heap->capacity);
+        }
+        free_heap(heap);
+    }
+}
+
+// Dijkstra on a random graph in CSR form, once with an indexed heap that
+// holds each vertex at most once (decrease_key on relaxation) and once
+// with a plain heap that pushes a duplicate per relaxation and skips
+// stale entries on extract. Both must produce the same distances.
+void benchmark_dijkstra(int vertices, int degree) {
+    int edges = vertices * degree;
+    int* offsets = (int*)malloc((vertices + 1) * sizeof(int));
+    int* targets = (int*)malloc(edges * sizeof(int));
+    int* weights = (int*)malloc(edges * sizeof(int));
+    int* dist_indexed = (int*)malloc(vertices * sizeof(int));
+    int* dist_lazy = (int*)malloc(vertices * sizeof(int));
+    int* vertex_handles = (int*)malloc(vertices * sizeof(int));
+    
+    if (!offsets || !targets || !weights || !dist_indexed || !dist_lazy || !vertex_handles) {
+        printf("Memory allocation failed!\n");
+        goto dijkstra_cleanup;
+    }
+    
+    for (int v = 0; v <= vertices; v++) {
+        offsets[v] = v * degree;
+    }
+    for (int e = 0; e < edges; e++) {
+        targets[e] = rand() % vertices;
+        weights[e] = 1 + rand() % 1000;
+    }
+    
+    printf("\n=== Dijkstra: %d vertices, %d edges ===\n", vertices, edges);
+    printf("%-24s %-10s %-14s %s\n", "Queue", "Time (s)", "Max heap size", "Extracts");
+    
+    // Indexed heap: one entry per vertex, decrease_key on relaxation
+    Heap* heap = create_indexed_heap(INITIAL_HEAP_CAPACITY, false, 4);
+    if (!heap) {
+        printf("Memory allocation failed!\n");
+        goto dijkstra_cleanup;
+    }
+    
+    for (int v = 0; v < vertices; v++) {
+        dist_indexed[v] = INT_MAX;
+        vertex_handles[v] = -1;
+    }
+    
+    int max_size = 0;
+    long extracts = 0;
+    clock_t start = clock();
+    
+    dist_indexed[0] = 0;
+    vertex_handles[0] = insert_heap_handle(heap, 0, 0);
+    while (!is_heap_empty(heap)) {
+        PQElement top = extract_heap(heap);
+        int u = top.data;
+        extracts++;
+        
+        for (int e = offsets[u]; e < offsets[u + 1]; e++) {
+            int v = targets[e];
+            int candidate = top.priority + weights[e];
+            if (candidate >= dist_indexed[v]) continue;
+            
+            if (dist_indexed[v] == INT_MAX) {
+                vertex_handles[v] = insert_heap_handle(heap, v, candidate);
+            } else {
+                decrease_key(heap, vertex_handles[v], candidate);
+            }
+            dist_indexed[v] = candidate;
+        }
+        if (heap->size > max_size) max_size = heap->size;
+    }
+    
+    double indexed_time = ((double)(clock() - start)) / CLOCKS_PER_SEC;
+    printf("%-24s %-10.4f %-14d %ld\n", "Indexed (decrease-key)", indexed_time, max_size, extracts);
+    free_heap(heap);
+    
+    // Plain heap: push a duplicate per relaxation, skip stale entries
+    heap = create_heap_dary(INITIAL_HEAP_CAPACITY, false, 4);
+    if (!heap) {
+        printf("Memory allocation failed!\n");
+        goto dijkstra_cleanup;
+    }
+    
+    for (int v = 0; v < vertices; v++) {
+        dist_lazy[v] = INT_MAX;
+    }
+    
+    max_size = 0;
+    extracts = 0;
+    start = clock();
+    
+    dist_lazy[0] = 0;
+    insert_heap(heap, 0, 0);
+    while (!is_heap_empty(heap)) {
+        PQElement top = extract_heap(heap);
+        int u = top.data;
+        extracts++;
+        if (top.priority > dist_lazy[u]) continue;
+        
+        for (int e = offsets[u]; e < offsets[u + 1]; e++) {
+            int v = targets[e];
+            int candidate = top.priority + weights[e];
+            if (candidate < dist_lazy[v]) {
+                dist_lazy[v] = candidate;
+                insert_heap(heap, v, candidate);
+            }
+        }
+        if (heap->size > max_size) max_size = heap->size;
+    }
+    
+    double lazy_time = ((double)(clock() - start)) / CLOCKS_PER_SEC;
+    printf("%-24s %-10.4f %-14d %ld\n", "Lazy (duplicates)", lazy_time, max_size, extracts);
+    free_heap(heap);
+    
+    printf("Distances match: %s\n",
+           memcmp(dist_indexed, dist_lazy, vertices * sizeof(int)) == 0 ? "Yes" : "No");
+
+dijkstra_cleanup:
+    free(offsets);
+    free(targets);
+    free(weights);
+    free(dist_indexed);
+    free(dist_lazy);
+    free(vertex_handles);
+}
+
+// Runs the same two workloads through every engine via the PriorityQueue
+// interface. "Sort" inserts n random keys then drains; "Hold" is the
+// event-simulation pattern: extract the minimum and insert a later event,
+// keeping n pending. Both are monotone, so the radix heap can take part.
+void benchmark_pq_engines(int n) {
+    int holds = 4 * n;
+    int* keys = (int*)malloc(n * sizeof(int));
+    int* delays = (int*)malloc(holds * sizeof(int));
+    
+    if (!keys || !delays) {
+        printf("Memory allocation failed!\n");
+        free(keys);
+        free(delays);
+        return;
+    }
+    
+    for (int i = 0; i < n; i++) keys[i] = rand();
+    for (int i = 0; i < holds; i++) delays[i] = 1 + rand() % 1000;
+    
+    printf("\n=== Priority Queue Engines (min-queue, n = %d) ===\n", n);
+    printf("%-14s %-10s %-10s %-16s %s\n", "Engine", "Sort (s)", "Hold (s)", "Checksum",
+           "Valid");
+    
+    for (int engine = 0; engine < PQ_ENGINE_COUNT; engine++) {
+        PriorityQueue* pq = pq_create((PQEngine)engine, false);
+        if (!pq) {
+            printf("Memory allocation failed!\n");
+            break;
+        }
+        
+        bool valid = true;
+        long long checksum = 0;
+        
+        clock_t start = clock();
+        for (int i = 0; i < n; i++) {
+            if (!pq_insert(pq, i, keys[i])) valid = false;
+        }
+        int previous = INT_MIN;
+        while (!pq_is_empty(pq)) {
+            PQElement e;
+            if (!pq_extract(pq, &e)) {
+                valid = false;
+                break;
+            }
+            if (e.priority < previous) valid = false;
+            previous = e.priority;
+            checksum += e.priority;
+        }
+        double sort_time = ((double)(clock() - start)) / CLOCKS_PER_SEC;
+        
+        // Pending events start in [0, 1000); each hold reschedules the
+        // earliest one up to 1000 ticks later, so keys stay below 5001 * n
+        for (int i = 0; i < n; i++) {
+            if (!pq_insert(pq, i, keys[i] % 1000)) valid = false;
+        }
+        start = clock();
+        previous = INT_MIN;
+        for (int i = 0; i < holds; i++) {
+            PQElement e;
+            if (!pq_extract(pq, &e)) {
+                valid = false;
+                break;
+            }
+            if (e.priority < previous) valid = false;
+            previous = e.priority;
+            checksum += e.priority;
+            if (!pq_insert(pq, e.data, e.priority + delays[i])) valid = false;
+        }
+        double hold_time = ((double)(clock() - start)) / CLOCKS_PER_SEC;
+        
+        printf("%-14s %-10.4f %-10.4f %-16lld %s\n", pq_engine_name((PQEngine)engine), sort_time,
+               hold_time, checksum, valid ? "Yes" : "No");
+        pq_free(pq);
+    }
+    
+    free(keys);
+    free(delays);
+}
+
+// Micro-batched scheduler pattern on a 4-ary min-heap holding n elements:
+// n more arrive in batches of each size and are then drained in batches,
+// comparing per-element calls with insert_batch / extract_top_k
+void benchmark_batch_ops(int n) {
+    const int batch_sizes[] = {16, 64, 256, 4096};
+    int num_batch_sizes = sizeof(batch_sizes) / sizeof(batch_sizes[0]);
+    PQElement* input = (PQElement*)malloc(2 * n * sizeof(PQElement));
+    PQElement* out = (PQElement*)malloc(batch_sizes[num_batch_sizes - 1] * sizeof(PQElement));
+    
+    if (!input || !out) {
+        printf("Memory allocation failed!\n");
+        free(input);
+        free(out);
+        return;
+    }
+    
+    for (int i = 0; i < 2 * n; i++) {
+        input[i].data = i;
+        input[i].priority = rand();
+    }
+    
+    printf("\n=== Batch Operations (4-ary min-heap, %d resident + %d arriving) ===\n", n, n);
+    
+    // Initial fill: n single inserts against one O(n) build
+    Heap* heap = create_heap_dary(2 * n, false, 4);
+    if (!heap) {
+        printf("Memory allocation failed!\n");
+        free(input);
+        free(out);
+        return;
+    }
+    
+    clock_t start = clock();
+    for (int i = 0; i < n; i++) {
+        insert_heap(heap, input[i].data, input[i].priority);
+    }
+    double insert_fill = ((double)(clock() - start)) / CLOCKS_PER_SEC;
+    
+    start = clock();
+    build_heap(heap, input, n);
+    double build_fill = ((double)(clock() - start)) / CLOCKS_PER_SEC;
+    free_heap(heap);
+    
+    printf("Fill %d: insert_heap loop %.4f s, build_heap %.4f s\n", n, insert_fill, build_fill);
+    printf("%-8s %-12s %-14s %-12s %-14s %s\n", "Batch", "Insert (s)", "insert_batch",
+           "Extract (s)", "extract_top_k", "Same order");
+    
+    for (int b = 0; b < num_batch_sizes; b++) {
+        int batch = batch_sizes[b];
+        double times[2][2];
+        long long checksums[2] = {0, 0};
+        
+        for (int mode = 0; mode < 2; mode++) {
+            heap = create_heap_dary(2 * n, false, 4);
+            if (!heap || !build_heap(heap, input, n)) {
+                printf("Memory allocation failed!\n");
+                free_heap(heap);
+                free(input);
+                free(out);
+                return;
+            }
+            
+            start = clock();
+            for (int offset = n; offset < 2 * n; offset += batch) {
+                int count = 2 * n - offset < batch ? 2 * n - offset : batch;
+                if (mode == 0) {
+                    for (int i = 0; i < count; i++) {
+                        insert_heap(heap, input[offset + i].data, input[offset + i].priority);
+                    }
+                } else {
+                    insert_batch(heap, input + offset, count);
+                }
+            }
+            times[mode][0] = ((double)(clock() - start)) / CLOCKS_PER_SEC;
+            
+            start = clock();
+            long long position = 0;
+            while (!is_heap_empty(heap)) {
+                int count;
+                if (mode == 0) {
+                    for (count = 0; count < batch && !is_heap_empty(heap); count++) {
+                        out[count] = extract_heap(heap);
+                    }
+                } else {
+                    count = extract_top_k(heap, out, batch);
+                }
+                // Position-weighted so a reordering changes the checksum
+                for (int i = 0; i < count; i++) {
+                    checksums[mode] += (long long)out[i].priority * (++position % 7);
+                }
+            }
+            times[mode][1] = ((double)(clock() - start)) / CLOCKS_PER_SEC;
+            free_heap(heap);
+        }
+        
+        printf("%-8d %-12.4f %-14.4f %-12.4f %-14.4f %s\n", batch, times[0][0], times[1][0],
+               times[0][1], times[1][1], checksums[0] == checksums[1] ? "Yes" : "No");
+    }
+    
+    free(input);
+    free(out);
+}
+
+double heap_wall_time(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+typedef struct {
+    MultiQueue* mq;         // NULL: use heap under heap_lock
+    Heap* heap;
+    pthread_mutex_t* heap_lock;
+    int operations;         // insert + extract pairs
+    unsigned int seed;
+    long long extracted;
+} ConcurrentPQArgs;
+
+// Each operation inserts a random key then extracts one element
+void* concurrent_pq_worker(void* arg) {
+    ConcurrentPQArgs* args = (ConcurrentPQArgs*)arg;
+    unsigned int rng = args->seed;
+    PQElement element;
+    
+    for (int i = 0; i < args->operations; i++) {
+        int priority = (int)(mq_random(&rng) & INT_MAX);
+        
+        if (args->mq) {
+            mq_insert(args->mq, &rng, i, priority);
+            if (mq_extract(args->mq, &rng, &element)) args->extracted++;
+        } else {
+            pthread_mutex_lock(args->heap_lock);
+            insert_heap(args->heap, i, priority);
+            if (!is_heap_empty(args->heap)) {
+                extract_heap(args->heap);
+                args->extracted++;
+            }
+            pthread_mutex_unlock(args->heap_lock);
+        }
+    }
+    
+    return NULL;
+}
+
+// Throughput of the mutex-wrapped Heap against a MultiQueue with two
+// shards per thread, both prefilled with n elements, as threads double up
+// to max_threads. Every run must extract one element per operation.
+void benchmark_concurrent_pq(int n, int max_threads) {
+    const int total_operations = 2000000;
+    
+    pthread_t* threads = (pthread_t*)malloc(max_threads * sizeof(pthread_t));
+    ConcurrentPQArgs* args = (ConcurrentPQArgs*)malloc(max_threads * sizeof(ConcurrentPQArgs));
+    if (!threads || !args) {
+        printf("Memory allocation failed!\n");
+        free(threads);
+        free(args);
+        return;
+    }
+    
+    printf("\n=== Concurrent Priority Queue (%d prefilled, %d insert+extract ops) ===\n",
+           n, total_operations);
+    printf("%-8s %-22s %-22s %s\n", "Threads", "Locked Heap (Mops/s)", "MultiQueue (Mops/s)",
+           "All extracted");
+    
+    for (int num_threads = 1; num_threads <= max_threads; num_threads *= 2) {
+        double throughput[2];
+        bool complete = true;
+        
+        for (int mode = 0; mode < 2; mode++) {
+            Heap* heap = NULL;
+            MultiQueue* mq = NULL;
+            pthread_mutex_t heap_lock;
+            unsigned int rng = 12345;
+            
+            if (mode == 0) {
+                heap = create_heap_dary(INITIAL_HEAP_CAPACITY, false, 4);
+                for (int i = 0; heap && i < n; i++) {
+                    insert_heap(heap, i, (int)(mq_random(&rng) & INT_MAX));
+                }
+            } else {
+                mq = create_multiqueue(2 * num_threads, false);
+                for (int i = 0; mq && i < n; i++) {
+                    mq_insert(mq, &rng, i, (int)(mq_random(&rng) & INT_MAX));
+                }
+            }
+            if (!heap && !mq) {
+                printf("Memory allocation failed!\n");
+                free(threads);
+                free(args);
+                return;
+            }
+            if (heap) {
+                pthread_mutex_init(&heap_lock, NULL);
+            }
+            
+            int per_thread = total_operations / num_threads;
+            int started = 0;
+            double start = heap_wall_time();
+            
+            for (int t = 0; t < num_threads; t++) {
+                args[t].mq = mq;
+                args[t].heap = heap;
+                args[t].heap_lock = &heap_lock;
+                args[t].operations = per_thread;
+                args[t].seed = 2654435761u * (unsigned int)(t + 1);
+                args[t].extracted = 0;
+                if (pthread_create(&threads[t], NULL, concurrent_pq_worker, &args[t]) != 0) {
+                    break;
+                }
+                started++;
+            }
+            
+            long long extracted = 0;
+            for (int t = 0; t < started; t++) {
+                pthread_join(threads[t], NULL);
+                extracted += args[t].extracted;
+            }
+            double elapsed = heap_wall_time() - start;
+            
+            throughput[mode] = (double)per_thread * started / elapsed / 1e6;
+            if (started < num_threads || extracted != (long long)per_thread * num_threads) {
+                complete = false;
+            }
+            
+            if (mode == 0) {
+                pthread_mutex_destroy(&heap_lock);
+                free_heap(heap);
+            } else {
+                free_multiqueue(mq);
+            }
+        }
+        
+        printf("%-8d %-22.3f %-22.3f %s\n", num_threads, throughput[0], throughput[1],
+               complete ? "Yes" : "No");
+    }
+    
+    free(threads);
+    free(args);
+}
+
+// Build-phase and full heap sort times as the build threads double up to
+// max_threads, each on a copy of the same random input
+void benchmark_parallel_heap_build(int n, int max_threads) {
+    int* original = (int*)malloc(n * sizeof(int));
+    int* arr = (int*)malloc(n * sizeof(int));
+    
+    if (!original || !arr) {
+        printf("Memory allocation failed!\n");
+        free(original);
+        free(arr);
+        return;
+    }
+    
+    generate_random_array(original, n, INT_MAX);
+    
+    printf("\n=== Parallel Heap Build (%d elements) ===\n", n);
+    printf("%-8s %-11s %-14s %-14s %-14s %s\n", "Threads", "Build (s)", "Build speedup",
+           "Sort (s)", "Sort speedup", "Sorted");
+    
+    double base_build = 0, base_sort = 0;
+    
+    for (int num_threads = 1; num_threads <= max_threads; num_threads *= 2) {
+        memcpy(arr, original, n * sizeof(int));
+        double start = heap_wall_time();
+        build_max_heap_parallel(arr, n, num_threads);
+        double build_time = heap_wall_time() - start;
+        
+        memcpy(arr, original, n * sizeof(int));
+        start = heap_wall_time();
+        heap_sort_ascending_parallel(arr, n, num_threads);
+        double sort_time = heap_wall_time() - start;
+        
+        if (num_threads == 1) {
+            base_build = build_time;
+            base_sort = sort_time;
+        }
+        
+        printf("%-8d %-11.4f %-14.2f %-14.4f %-14.2f %s\n", num_threads, build_time,
+               base_build / build_time, sort_time, base_sort / sort_time,
+               is_sorted_ascending(arr, n) ? "Yes" : "No");
+    }
+    
+    free(original);
+    free(arr);
+}
@@ -0,0 +1,159 @@
+#ifndef MEMORY_POOL_H
+#define MEMORY_POOL_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// Fixed-size node pool for the linked structures (BST nodes, circular list
+// nodes, graph adjacency entries).
+//
+// A NodePool hands out slots of one size, carved in order from
+// NODE_POOL_BLOCK_BYTES blocks. pool_free pushes a slot onto the pool's own
+// free list and pool_alloc pops it again, so a structure under churn reuses
+// its recently freed, cache-warm slots and never goes back to malloc once
+// its working set is reached. pool_destroy releases every node at once by
+// freeing the blocks, which replaces a walk over the whole structure.
+//
+// Give each structure (or each node type) its own pool. Freed slots are
+// only returned to the system by pool_destroy.
+//
+// Pooling is opt-in: compile with -DUSE_NODE_POOL. Without the flag a pool
+// starts in pass-through mode, where pool_alloc/pool_free are plain
+// malloc/free and pool_destroy frees nothing, so callers must still free
+// each node (see pool_owns_nodes). Both modes keep the same counters, and
+// use_malloc may be set on an empty pool to compare them in one binary.
+
+#define NODE_POOL_BLOCK_BYTES 65536
+#define NODE_POOL_ALIGN 16
+
+#define NODE_POOL_SLOT_SIZE(size) \
+    (((size) + NODE_POOL_ALIGN - 1) / NODE_POOL_ALIGN * NODE_POOL_ALIGN)
+
+#ifdef USE_NODE_POOL
+#define NODE_POOL_USE_MALLOC false
+#else
+#define NODE_POOL_USE_MALLOC true
+#endif
+
+// Static initializer for a pool of nodes of the given type
+#define NODE_POOL_INITIALIZER(type) \
+    { NODE_POOL_SLOT_SIZE(sizeof(type)), NODE_POOL_USE_MALLOC, NULL, NULL, NULL, NULL, 0, 0, 0, 0 }
+
+typedef struct PoolBlock {
+    struct PoolBlock* next;
+} PoolBlock;
+
+typedef struct PoolSlot {
+    struct PoolSlot* next;
+} PoolSlot;
+
+typedef struct NodePool {
+    size_t slot_size;
+    bool use_malloc;     // Pass-through mode: one malloc/free per node
+    PoolBlock* blocks;
+    PoolSlot* free_list;
+    char* bump;          // Next never-used slot in the newest block
+    char* bump_end;
+    size_t allocs;
+    size_t frees;
+    size_t malloc_calls; // Blocks, or nodes in pass-through mode
+    size_t live_blocks;
+} NodePool;
+
+static inline void pool_init(NodePool* pool, size_t node_size) {
+    size_t size = node_size < sizeof(PoolSlot) ? sizeof(PoolSlot) : node_size;
+
+    pool->slot_size = NODE_POOL_SLOT_SIZE(size);
+    pool->use_malloc = NODE_POOL_USE_MALLOC;
+    pool->blocks = NULL;
+    pool->free_list = NULL;
+    pool->bump = pool->bump_end = NULL;
+    pool->allocs = pool->frees = pool->malloc_calls = pool->live_blocks = 0;
+}
+
+// True when pool_destroy releases the nodes, so no per-node walk is needed
+static inline bool pool_owns_nodes(const NodePool* pool) {
+    return !pool->use_malloc;
+}
+
+static inline bool pool_grow(NodePool* pool) {
+    size_t count = (NODE_POOL_BLOCK_BYTES - NODE_POOL_ALIGN) / pool->slot_size;
+    if (count == 0) count = 1;
+
+    // The block header takes one alignment unit so slots stay aligned
+    char* block = (char*)malloc(NODE_POOL_ALIGN + count * pool->slot_size);
+    if (!block) return false;
+    pool->malloc_calls++;
+    pool->live_blocks++;
+
+    ((PoolBlock*)block)->next = pool->blocks;
+    pool->blocks = (PoolBlock*)block;
+    pool->bump = block + NODE_POOL_ALIGN;
+    pool->bump_end = pool->bump + count * pool->slot_size;
+    return true;
+}
+
+// Returns NULL if the pool (or malloc) is out of memory
+static inline void* pool_alloc(NodePool* pool) {
+    if (pool->use_malloc) {
+        void* node = malloc(pool->slot_size);
+        if (!node) return NULL;
+        pool->allocs++;
+        pool->malloc_calls++;
+        return node;
+    }
+
+    void* node;
+    if (pool->free_list) {
+        node = pool->free_list;
+        pool->free_list = pool->free_list->next;
+    } else {
+        if (pool->bump == pool->bump_end && !pool_grow(pool)) return NULL;
+        node = pool->bump;
+        pool->bump += pool->slot_size;
+    }
+
+    pool->allocs++;
+    return node;
+}
+
+static inline void pool_free(NodePool* pool, void* node) {
+    if (!node) return;
+    pool->frees++;
+
+    if (pool->use_malloc) {
+        free(node);
+        return;
+    }
+
+    PoolSlot* slot = (PoolSlot*)node;
+    slot->next = pool->free_list;
+    pool->free_list = slot;
+}
+
+// Frees every block, invalidating all pooled nodes still in use. The pool
+// stays initialised and can be reused; the counters are kept.
+static inline void pool_destroy(NodePool* pool) {
+    PoolBlock* block = pool->blocks;
+    while (block) {
+        PoolBlock* next = block->next;
+        free(block);
+        block = next;
+    }
+
+    if (!pool->use_malloc) pool->frees = pool->allocs;
+    pool->blocks = NULL;
+    pool->free_list = NULL;
+    pool->bump = pool->bump_end = NULL;
+    pool->live_blocks = 0;
+}
+
+static inline void pool_print_stats(const NodePool* pool, const char* label) {
+    printf("%s: %s, %zu-byte slots, %zu allocs, %zu frees, %zu malloc calls, %zu blocks\n",
+           label, pool->use_malloc ? "malloc" : "pool", pool->slot_size, pool->allocs,
+           pool->frees, pool->malloc_calls, pool->live_blocks);
+}
+
+#endif
@@ -0,0 +1,154 @@
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+// Optional hardware performance counters for the sort/search kernels.
+//
+// Compile with -DENABLE_PERF_COUNTERS to count cycles, instructions,
+// L1D and LLC read misses and branch mispredicts through Linux
+// perf_event_open(2). Without the flag PERF_MEASURE expands to the bare
+// statement and nothing else in this header generates code.
+//
+//     PERF_MEASURE("quicksort_hybrid", size,
+//                  quicksort_hybrid(arr, 0, size - 1, MEDIAN_OF_THREE));
+//
+// prints each counter divided by the element count. Counters that the
+// kernel or CPU does not provide (common in VMs) are reported as n/a.
+// Include this header before any system header: the enabled build needs
+// _GNU_SOURCE for syscall().
+
+#ifdef ENABLE_PERF_COUNTERS
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+typedef enum {
+    PERF_CYCLES,
+    PERF_INSTRUCTIONS,
+    PERF_L1D_MISSES,
+    PERF_LLC_MISSES,
+    PERF_BRANCH_MISSES,
+    PERF_COUNTER_COUNT
+} PerfCounterId;
+
+typedef struct {
+    int fds[PERF_COUNTER_COUNT];
+    double values[PERF_COUNTER_COUNT];  // Scaled for multiplexing; < 0 if unavailable
+} PerfCounters;
+
+static const char* const perf_counter_names[PERF_COUNTER_COUNT] = {
+    "cycles", "instructions", "l1d_misses", "llc_misses", "branch_misses"
+};
+
+static inline void perf_counters_open(PerfCounters* pc) {
+    static const unsigned int types[PERF_COUNTER_COUNT] = {
+        PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HW_CACHE,
+        PERF_TYPE_HW_CACHE, PERF_TYPE_HARDWARE
+    };
+    static const unsigned long long configs[PERF_COUNTER_COUNT] = {
+        PERF_COUNT_HW_CPU_CYCLES,
+        PERF_COUNT_HW_INSTRUCTIONS,
+        PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+            (PERF_COUNT_HW_CACHE_RESULT_MISS << 16),
+        PERF_COUNT_HW_CACHE_LL | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+            (PERF_COUNT_HW_CACHE_RESULT_MISS << 16),
+        PERF_COUNT_HW_BRANCH_MISSES
+    };
+
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++) {
+        struct perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = types[i];
+        attr.config = configs[i];
+        attr.disabled = 1;
+        attr.inherit = 1;  // Also count threads spawned by parallel kernels
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+        pc->fds[i] = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+        pc->values[i] = -1;
+    }
+}
+
+static inline void perf_counters_start(PerfCounters* pc) {
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++) {
+        if (pc->fds[i] >= 0) {
+            ioctl(pc->fds[i], PERF_EVENT_IOC_RESET, 0);
+            ioctl(pc->fds[i], PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+}
+
+static inline void perf_counters_stop(PerfCounters* pc) {
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++) {
+        if (pc->fds[i] >= 0) {
+            ioctl(pc->fds[i], PERF_EVENT_IOC_DISABLE, 0);
+        }
+    }
+
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++) {
+        unsigned long long data[3];  // value, time enabled, time running
+        pc->values[i] = -1;
+
+        if (pc->fds[i] >= 0 && read(pc->fds[i], data, sizeof(data)) == (ssize_t)sizeof(data)) {
+            if (data[2] > 0) {
+                pc->values[i] = (double)data[0] * (double)data[1] / (double)data[2];
+            }
+        }
+    }
+}
+
+static inline void perf_counters_close(PerfCounters* pc) {
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++) {
+        if (pc->fds[i] >= 0) {
+            close(pc->fds[i]);
+            pc->fds[i] = -1;
+        }
+    }
+}
+
+static inline void perf_counters_report(FILE* out, const char* label, long elements,
+                                        const PerfCounters* pc) {
+    fprintf(out, "[perf] %s (per element):", label);
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++) {
+        if (pc->values[i] >= 0 && elements > 0) {
+            fprintf(out, " %s=%.3f", perf_counter_names[i], pc->values[i] / (double)elements);
+        } else {
+            fprintf(out, " %s=n/a", perf_counter_names[i]);
+        }
+    }
+    fprintf(out, "\n");
+}
+
+#define PERF_MEASURE(label, elements, statement)                    \
+    do {                                                            \
+        PerfCounters perf_counters_;                                \
+        perf_counters_open(&perf_counters_);                        \
+        perf_counters_start(&perf_counters_);                       \
+        statement;                                                  \
+        perf_counters_stop(&perf_counters_);                        \
+        perf_counters_report(stdout, (label), (long)(elements),     \
+                             &perf_counters_);                      \
+        perf_counters_close(&perf_counters_);                       \
+    } while (0)
+
+#else
+
+#define PERF_MEASURE(label, elements, statement) \
+    do {                                         \
+        statement;                               \
+    } while (0)
+
+#endif
+
+#endif
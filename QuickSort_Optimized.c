@@ -1,11 +1,38 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "PerfCounters.h"
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
 #include <time.h>
 #include <string.h>
+#include <limits.h>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+
+#include "GenericSort.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define SIMD_SORT_AVAILABLE 1
+#endif
 
 #define MAX_SIZE 10000
 #define INSERTION_SORT_THRESHOLD 10
+#define SORTING_NETWORK_SIZE 16
+#define MAX_PARALLEL_SIZE 100000000
+#define PARALLEL_CUTOFF 16384
+#define MAX_WORKER_THREADS 256
+#define BLOCK_PARTITION_SIZE 128
+#define BENCHMARK_SEED 12345u
+#define TIMSORT_MIN_MERGE 32
+#define TIMSORT_MIN_GALLOP 7
+#define TIMSORT_MAX_RUNS 85
+#define SAMPLE_SORT_OVERSAMPLING 32
+#define SAMPLE_SORT_BUCKETS_PER_THREAD 4
+#define SAMPLE_SORT_MAX_BUCKETS 256
 
 // Pivot selection strategies
 typedef enum {
@@ -16,6 +43,16 @@ typedef enum {
     RANDOM_ELEMENT
 } PivotStrategy;
 
+// Base case used for subarrays at or below small_sort_threshold
+typedef enum {
+    SMALL_SORT_INSERTION,
+    SMALL_SORT_NETWORK_SCALAR,
+    SMALL_SORT_NETWORK_SIMD  // AVX2 when the CPU has it, scalar network otherwise
+} SmallSortMode;
+
+SmallSortMode small_sort_mode = SMALL_SORT_NETWORK_SIMD;
+int small_sort_threshold = SORTING_NETWORK_SIZE;
+
 // Stack for iterative quicksort
 typedef struct {
     int low;
@@ -27,19 +64,156 @@ typedef struct {
     int top;
 } Stack;
 
+// Per-worker task deque for parallel quicksort: the owner pushes and pops
+// at the tail, idle workers steal the oldest (largest) ranges from the head
+typedef struct {
+    StackFrame* tasks;
+    int head;
+    int tail;
+    int capacity;
+    pthread_mutex_t lock;
+} TaskDeque;
+
+typedef struct {
+    int* arr;
+    PivotStrategy strategy;
+    int num_threads;
+    TaskDeque* deques;
+    long pending;  // Ranges pushed but not yet fully sorted
+} ParallelSortContext;
+
+typedef struct {
+    ParallelSortContext* ctx;
+    int id;
+    unsigned int seed;
+} WorkerArgs;
+
+// Pending runs for timsort; run i is arr[run_base[i] .. run_base[i] + run_len[i])
+typedef struct {
+    int* arr;
+    int* tmp;
+    int min_gallop;
+    int run_base[TIMSORT_MAX_RUNS];
+    int run_len[TIMSORT_MAX_RUNS];
+    int stack_size;
+} TimSortState;
+
+// Shared state for parallel sample sort. counts holds a per-thread
+// bucket histogram, which becomes per-thread scatter offsets once
+// prefix-summed in bucket-major order.
+typedef struct {
+    int* arr;
+    int* buffer;
+    unsigned char* bucket_of;  // Bucket index per element from the classify phase
+    int n;
+    int num_threads;
+    int num_buckets;
+    int* splitters;            // num_buckets - 1 ascending keys
+    int* counts;               // num_threads x num_buckets
+    int* bucket_start;         // num_buckets + 1 offsets into buffer
+    int next_bucket;           // Claimed atomically in the sort phase
+} SampleSortContext;
+
+typedef enum {
+    SAMPLE_CLASSIFY,
+    SAMPLE_SCATTER,
+    SAMPLE_SORT_BUCKETS
+} SampleSortPhase;
+
+typedef struct {
+    SampleSortContext* ctx;
+    int id;
+    SampleSortPhase phase;
+} SampleSortArgs;
+
+// Record types sorted in place through the generic sort API
+typedef struct {
+    int key;
+    int id;
+    double value;
+} Record;
+
+typedef struct {
+    int key;
+    int index;
+} KeyIndex;
+
+#define RECORD_LESS(a, b) ((a).key < (b).key)
+#define KEY_INDEX_LESS(a, b) ((a).key < (b).key)
+#define INT_LESS(a, b) ((a) < (b))
+
+DEFINE_SORT(record, Record, RECORD_LESS)
+DEFINE_SORT(key_index, KeyIndex, KEY_INDEX_LESS)
+DEFINE_STABLE_SORT(int, int, INT_LESS)
+DEFINE_STABLE_SORT(record, Record, RECORD_LESS)
+
 // Function prototypes
 void quicksort_recursive(int arr[], int low, int high, PivotStrategy strategy);
 void quicksort_iterative(int arr[], int low, int high, PivotStrategy strategy);
 void quicksort_hybrid(int arr[], int low, int high, PivotStrategy strategy);
+void quicksort_parallel(int arr[], int low, int high, PivotStrategy strategy, int num_threads);
+void merge_sort_parallel(int arr[], int low, int high, int num_threads);
+void sample_sort(int arr[], int low, int high, int num_threads);
+void quicksort_block(int arr[], int low, int high, PivotStrategy strategy);
+void quicksort_introsort(int arr[], int low, int high, PivotStrategy strategy);
+void quicksort_three_way(int arr[], int low, int high, PivotStrategy strategy);
+void partition_three_way(int arr[], int low, int high, PivotStrategy strategy, int* lt, int* gt);
+void radix_sort(int arr[], int low, int high, int digit_bits);
+void timsort(int arr[], int low, int high);
+int timsort_min_run(int n);
+int timsort_count_run(int arr[], int low, int end);
+void timsort_binary_insertion(int arr[], int low, int end, int start);
+void timsort_merge_collapse(TimSortState* state);
+void timsort_merge_at(TimSortState* state, int k);
+void timsort_merge_lo(TimSortState* state, int base1, int len1, int base2, int len2);
+void timsort_merge_hi(TimSortState* state, int base1, int len1, int base2, int len2);
+int gallop_left(int key, int arr[], int base, int len, int hint);
+int gallop_right(int key, int arr[], int base, int len, int hint);
+void reverse_range(int arr[], int low, int high);
+void introsort_loop(int arr[], int low, int high, PivotStrategy strategy, int bad_allowed);
+void break_patterns(int arr[], int low, int high);
+void heap_sort_range(int arr[], int low, int high);
+void sift_down_range(int arr[], int n, int root);
+int floor_log2(int n);
 int partition(int arr[], int low, int high, PivotStrategy strategy);
+int partition_block(int arr[], int low, int high, PivotStrategy strategy);
 int select_pivot(int arr[], int low, int high, PivotStrategy strategy);
 void insertion_sort(int arr[], int low, int high);
+void small_sort(int arr[], int low, int high);
+void sort_network_scalar(int v[], int n);
+bool simd_sort_supported(void);
+#ifdef SIMD_SORT_AVAILABLE
+void sort_network_8_avx2(int v[]);
+void sort_network_16_avx2(int v[]);
+#endif
 void swap(int* a, int* b);
 int median_of_three(int arr[], int low, int high);
 void print_array(int arr[], int size);
 bool is_sorted(int arr[], int size);
 void generate_test_data(int arr[], int size, const char* type);
 void benchmark_sorts(int size);
+void benchmark_partition_schemes(int size);
+void benchmark_introsort(int size);
+void benchmark_radix(void);
+void benchmark_generic_sort(int size);
+void benchmark_small_sort(void);
+void benchmark_adaptive(int size);
+int compare_records(const void* a, const void* b);
+double get_wall_time(void);
+int default_thread_count(void);
+
+// Work-stealing task pool
+bool init_deque(TaskDeque* deque);
+void free_deque(TaskDeque* deque);
+bool push_task(TaskDeque* deque, int low, int high);
+bool pop_task(TaskDeque* deque, int* low, int* high);
+bool steal_task(TaskDeque* deque, int* low, int* high);
+void* parallel_sort_worker(void* args);
+void* sample_sort_worker(void* args);
+void run_sample_sort_phase(SampleSortContext* ctx, SampleSortPhase phase);
+int find_bucket(const int splitters[], int num_splitters, int key);
+bool is_stable_by_key(Record records[], int size);
+void check_stable_sort(int size, int num_threads);
 
 // Stack operations
 void init_stack(Stack* stack);
@@ -47,6 +221,7 @@ void push(Stack* stack, int low, int high);
 bool pop(Stack* stack, int* low, int* high);
 bool is_empty(Stack* stack);
 
+#ifndef QUICKSORT_NO_MAIN
 int main() {
     int choice, size, pivot_choice;
     int* arr = NULL;
@@ -54,13 +229,21 @@ int main() {
     double cpu_time_used;
     
     printf("=== Optimized QuickSort Implementation ===\n");
+    srand(time(NULL));
     
     while (1) {
         printf("\n=== MENU ===\n");
         printf("1. Sort user input array\n");
         printf("2. Sort random array\n");
         printf("3. Performance benchmark\n");
-        printf("4. Exit\n");
+        printf("4. Parallel sorts on random array (quicksort, merge, sample)\n");
+        printf("5. Partition scheme benchmark (Lomuto, block, three-way)\n");
+        printf("6. Introsort on adversarial inputs\n");
+        printf("7. Radix sort vs comparison sorts\n");
+        printf("8. Record sort benchmark (generic API vs qsort)\n");
+        printf("9. Small-partition base case benchmark and tuning\n");
+        printf("10. Adaptive sort (TimSort) on presorted inputs\n");
+        printf("11. Exit\n");
         printf("Enter your choice: ");
         
         if (scanf("%d", &choice) != 1) {
@@ -190,7 +373,8 @@ int main() {
                 if (size > 20) printf("... (%d more elements)\n", size - 20);
                 
                 start = clock();
-                quicksort_hybrid(arr, 0, size - 1, MEDIAN_OF_THREE);
+                PERF_MEASURE("quicksort_hybrid", size,
+                             quicksort_hybrid(arr, 0, size - 1, MEDIAN_OF_THREE));
                 end = clock();
                 cpu_time_used = ((double)(end - start)) / CLOCKS_PER_SEC;
                 
@@ -210,7 +394,138 @@ int main() {
                 benchmark_sorts(1000);
                 break;
                 
-            case 4:
+            case 4: {
+                int num_threads;
+                
+                printf("Enter array size (max %d): ", MAX_PARALLEL_SIZE);
+                if (scanf("%d", &size) != 1 || size <= 0 || size > MAX_PARALLEL_SIZE) {
+                    printf("Invalid size!\n");
+                    break;
+                }
+                printf("Enter thread count (0 = all %d online CPUs): ", default_thread_count());
+                if (scanf("%d", &num_threads) != 1 || num_threads < 0 ||
+                    num_threads > MAX_WORKER_THREADS) {
+                    printf("Invalid thread count!\n");
+                    break;
+                }
+                
+                arr = (int*)malloc(size * sizeof(int));
+                int* arr_sequential = (int*)malloc(size * sizeof(int));
+                if (!arr || !arr_sequential) {
+                    printf("Memory allocation failed!\n");
+                    free(arr);
+                    free(arr_sequential);
+                    arr = NULL;
+                    break;
+                }
+                
+                generate_test_data(arr, size, "random");
+                memcpy(arr_sequential, arr, size * sizeof(int));
+                
+                double wall_start = get_wall_time();
+                quicksort_hybrid(arr_sequential, 0, size - 1, MEDIAN_OF_THREE);
+                double sequential_time = get_wall_time() - wall_start;
+                
+                int* original = (int*)malloc(size * sizeof(int));
+                if (!original) {
+                    printf("Memory allocation failed!\n");
+                    free(arr);
+                    free(arr_sequential);
+                    arr = NULL;
+                    break;
+                }
+                memcpy(original, arr, size * sizeof(int));
+                
+                printf("\nSequential hybrid: %f seconds\n", sequential_time);
+                printf("%-26s %-12s %-10s %-8s %s\n", "Parallel sort", "Time (s)",
+                       "Speedup", "Sorted", "Matches sequential");
+                
+                const char* parallel_names[] = {"Quicksort (work-stealing)",
+                                                "Merge sort (stable)", "Sample sort"};
+                for (int k = 0; k < 3; k++) {
+                    memcpy(arr, original, size * sizeof(int));
+                    wall_start = get_wall_time();
+                    switch (k) {
+                        case 0: quicksort_parallel(arr, 0, size - 1, MEDIAN_OF_THREE, num_threads); break;
+                        case 1: merge_sort_parallel(arr, 0, size - 1, num_threads); break;
+                        case 2: sample_sort(arr, 0, size - 1, num_threads); break;
+                    }
+                    double parallel_time = get_wall_time() - wall_start;
+                    
+                    printf("%-26s %-12.6f %-10.2f %-8s %s\n", parallel_names[k], parallel_time,
+                           sequential_time / parallel_time, is_sorted(arr, size) ? "Yes" : "No",
+                           memcmp(arr, arr_sequential, size * sizeof(int)) == 0 ? "Yes" : "No");
+                }
+                printf("(%d threads)\n", num_threads > 0 ? num_threads : default_thread_count());
+                
+                check_stable_sort(size, num_threads);
+                
+                free(arr);
+                free(arr_sequential);
+                free(original);
+                arr = NULL;
+                break;
+            }
+            
+            case 5:
+                printf("Enter array size (max %d): ", MAX_PARALLEL_SIZE);
+                if (scanf("%d", &size) != 1 || size <= 0 || size > MAX_PARALLEL_SIZE) {
+                    printf("Invalid size!\n");
+                    break;
+                }
+                benchmark_partition_schemes(size);
+                break;
+                
+            case 6:
+                printf("Enter array size (max %d): ", MAX_PARALLEL_SIZE);
+                if (scanf("%d", &size) != 1 || size <= 0 || size > MAX_PARALLEL_SIZE) {
+                    printf("Invalid size!\n");
+                    break;
+                }
+                benchmark_introsort(size);
+                break;
+                
+            case 7:
+                benchmark_radix();
+                break;
+                
+            case 8:
+                printf("Enter record count (max %d): ", MAX_PARALLEL_SIZE);
+                if (scanf("%d", &size) != 1 || size <= 0 || size > MAX_PARALLEL_SIZE) {
+                    printf("Invalid size!\n");
+                    break;
+                }
+                benchmark_generic_sort(size);
+                break;
+                
+            case 9: {
+                int threshold;
+                
+                benchmark_small_sort();
+                printf("\nCurrent cutoff: %d. Enter new cutoff (2-64, 0 = keep): ",
+                       small_sort_threshold);
+                if (scanf("%d", &threshold) != 1 || threshold < 0 || threshold > 64 ||
+                    threshold == 1) {
+                    printf("Invalid cutoff!\n");
+                    break;
+                }
+                if (threshold > 0) {
+                    small_sort_threshold = threshold;
+                    printf("Small-partition cutoff set to %d.\n", small_sort_threshold);
+                }
+                break;
+            }
+            
+            case 10:
+                printf("Enter array size (max %d): ", MAX_PARALLEL_SIZE);
+                if (scanf("%d", &size) != 1 || size <= 0 || size > MAX_PARALLEL_SIZE) {
+                    printf("Invalid size!\n");
+                    break;
+                }
+                benchmark_adaptive(size);
+                break;
+                
+            case 11:
                 printf("Exiting program...\n");
                 if (arr) free(arr);
                 return 0;
@@ -224,6 +539,7 @@ int main() {
     
     return 0;
 }
+#endif
 
 void quicksort_recursive(int arr[], int low, int high, PivotStrategy strategy) {
     if (low < high) {
@@ -259,9 +575,9 @@ void quicksort_iterative(int arr[], int low, int high, PivotStrategy strategy) {
 
 void quicksort_hybrid(int arr[], int low, int high, PivotStrategy strategy) {
     if (low < high) {
-        // Use insertion sort for small subarrays
-        if (high - low + 1 <= INSERTION_SORT_THRESHOLD) {
-            insertion_sort(arr, low, high);
+        // Use the small-partition base case for small subarrays
+        if (high - low + 1 <= small_sort_threshold) {
+            small_sort(arr, low, high);
             return;
         }
         
@@ -271,137 +587,1862 @@ void quicksort_hybrid(int arr[], int low, int high, PivotStrategy strategy) {
     }
 }
 
-int partition(int arr[], int low, int high, PivotStrategy strategy) {
-    int pivot_index = select_pivot(arr, low, high, strategy);
+// Parallel quicksort: ranges above PARALLEL_CUTOFF are block-partitioned
+// and the smaller half is published on the worker's deque for others to
+// steal. Each task gets the introsort budget of floor(log2 size) bad
+// partitions, and ranges at or below the cutoff finish in introsort_loop,
+// so duplicate-heavy or adversarial input stays O(n log n) with bounded
+// stack depth. num_threads <= 0 uses all CPUs.
+void quicksort_parallel(int arr[], int low, int high, PivotStrategy strategy, int num_threads) {
+    if (num_threads <= 0) {
+        num_threads = default_thread_count();
+    }
+    if (num_threads > MAX_WORKER_THREADS) {
+        num_threads = MAX_WORKER_THREADS;
+    }
     
-    // Move pivot to end
-    swap(&arr[pivot_index], &arr[high]);
-    int pivot = arr[high];
+    if (num_threads == 1 || high - low + 1 <= PARALLEL_CUTOFF) {
+        quicksort_introsort(arr, low, high, strategy);
+        return;
+    }
     
-    int i = low - 1;
+    ParallelSortContext ctx;
+    ctx.arr = arr;
+    ctx.strategy = strategy;
+    ctx.num_threads = num_threads;
+    ctx.pending = 1;
+    ctx.deques = (TaskDeque*)malloc(num_threads * sizeof(TaskDeque));
     
-    for (int j = low; j < high; j++) {
-        if (arr[j] <= pivot) {
-            i++;
-            swap(&arr[i], &arr[j]);
+    pthread_t* threads = (pthread_t*)malloc(num_threads * sizeof(pthread_t));
+    WorkerArgs* args = (WorkerArgs*)malloc(num_threads * sizeof(WorkerArgs));
+    
+    if (!ctx.deques || !threads || !args) {
+        free(ctx.deques);
+        free(threads);
+        free(args);
+        quicksort_introsort(arr, low, high, strategy);
+        return;
+    }
+    
+    int initialized = 0;
+    while (initialized < num_threads && init_deque(&ctx.deques[initialized])) {
+        initialized++;
+    }
+    
+    if (initialized < num_threads || !push_task(&ctx.deques[0], low, high)) {
+        for (int i = 0; i < initialized; i++) {
+            free_deque(&ctx.deques[i]);
         }
+        free(ctx.deques);
+        free(threads);
+        free(args);
+        quicksort_introsort(arr, low, high, strategy);
+        return;
     }
     
-    swap(&arr[i + 1], &arr[high]);
-    return i + 1;
-}
-
-int select_pivot(int arr[], int low, int high, PivotStrategy strategy) {
-    switch (strategy) {
-        case FIRST_ELEMENT:
-            return low;
-        case LAST_ELEMENT:
-            return high;
-        case MIDDLE_ELEMENT:
-            return low + (high - low) / 2;
-        case MEDIAN_OF_THREE:
-            return median_of_three(arr, low, high);
-        case RANDOM_ELEMENT:
-            return low + rand() % (high - low + 1);
-        default:
-            return high;
+    for (int i = 0; i < num_threads; i++) {
+        args[i].ctx = &ctx;
+        args[i].id = i;
+        args[i].seed = 2463534242u + 97u * (unsigned int)i;
     }
-}
-
-int median_of_three(int arr[], int low, int high) {
-    int mid = low + (high - low) / 2;
     
-    if (arr[low] > arr[mid]) swap(&arr[low], &arr[mid]);
-    if (arr[mid] > arr[high]) swap(&arr[mid], &arr[high]);
-    if (arr[low] > arr[mid]) swap(&arr[low], &arr[mid]);
+    // The calling thread acts as worker 0; if a thread cannot be spawned,
+    // the remaining workers simply pick up its share of the work.
+    int spawned = 1;
+    for (int i = 1; i < num_threads; i++) {
+        if (pthread_create(&threads[i], NULL, parallel_sort_worker, &args[i]) != 0) {
+            break;
+        }
+        spawned++;
+    }
     
-    return mid;
+    parallel_sort_worker(&args[0]);
+    
+    for (int i = 1; i < spawned; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    
+    for (int i = 0; i < num_threads; i++) {
+        free_deque(&ctx.deques[i]);
+    }
+    free(ctx.deques);
+    free(threads);
+    free(args);
 }
 
-void insertion_sort(int arr[], int low, int high) {
-    for (int i = low + 1; i <= high; i++) {
-        int key = arr[i];
-        int j = i - 1;
+void* parallel_sort_worker(void* args) {
+    WorkerArgs* worker = (WorkerArgs*)args;
+    ParallelSortContext* ctx = worker->ctx;
+    TaskDeque* own = &ctx->deques[worker->id];
+    int low, high;
+    
+    while (1) {
+        bool found = pop_task(own, &low, &high);
         
-        while (j >= low && arr[j] > key) {
-            arr[j + 1] = arr[j];
-            j--;
+        // Steal from a random victim, scanning the others in order
+        if (!found) {
+            worker->seed ^= worker->seed << 13;
+            worker->seed ^= worker->seed >> 17;
+            worker->seed ^= worker->seed << 5;
+            int start = (int)(worker->seed % (unsigned int)ctx->num_threads);
+            
+            for (int k = 0; k < ctx->num_threads && !found; k++) {
+                int victim = (start + k) % ctx->num_threads;
+                if (victim != worker->id) {
+                    found = steal_task(&ctx->deques[victim], &low, &high);
+                }
+            }
         }
-        arr[j + 1] = key;
+        
+        if (!found) {
+            if (__atomic_load_n(&ctx->pending, __ATOMIC_ACQUIRE) == 0) {
+                break;
+            }
+            sched_yield();
+            continue;
+        }
+        
+        int bad_allowed = floor_log2(high - low + 1);
+        while (high - low + 1 > PARALLEL_CUTOFF) {
+            int size = high - low + 1;
+            int pivot_index = partition_block(ctx->arr, low, high, ctx->strategy);
+            int left_size = pivot_index - low;
+            int right_size = high - pivot_index;
+            
+            // Same bad-partition handling as introsort_loop
+            if ((left_size < right_size ? left_size : right_size) < size / 8) {
+                if (--bad_allowed <= 0) {
+                    heap_sort_range(ctx->arr, low, high);
+                    low = high;  // Nothing left for the leaf sort below
+                    break;
+                }
+                break_patterns(ctx->arr, low, pivot_index - 1);
+                break_patterns(ctx->arr, pivot_index + 1, high);
+            }
+            
+            // Publish the smaller half and keep working on the larger one
+            int push_low = left_size < right_size ? low : pivot_index + 1;
+            int push_high = left_size < right_size ? pivot_index - 1 : high;
+            
+            if (push_low < push_high) {
+                __atomic_add_fetch(&ctx->pending, 1, __ATOMIC_ACQ_REL);
+                if (!push_task(own, push_low, push_high)) {
+                    quicksort_introsort(ctx->arr, push_low, push_high, ctx->strategy);
+                    __atomic_sub_fetch(&ctx->pending, 1, __ATOMIC_ACQ_REL);
+                }
+            }
+            
+            if (left_size < right_size) {
+                low = pivot_index + 1;
+            } else {
+                high = pivot_index - 1;
+            }
+        }
+        
+        if (low < high) {
+            introsort_loop(ctx->arr, low, high, ctx->strategy, bad_allowed);
+        }
+        __atomic_sub_fetch(&ctx->pending, 1, __ATOMIC_ACQ_REL);
     }
+    
+    return NULL;
 }
 
-void swap(int* a, int* b) {
-    if (a != b) {
-        int temp = *a;
-        *a = *b;
-        *b = temp;
+// Stable parallel merge sort (GenericSort.h) on int keys. Falls back to
+// the unstable introsort only if the scratch buffer cannot be allocated,
+// which for plain ints is indistinguishable.
+void merge_sort_parallel(int arr[], int low, int high, int num_threads) {
+    if (num_threads <= 0) {
+        num_threads = default_thread_count();
+    }
+    if (num_threads > MAX_WORKER_THREADS) {
+        num_threads = MAX_WORKER_THREADS;
+    }
+    
+    if (!int_stable_sort(arr, low, high, num_threads)) {
+        quicksort_introsort(arr, low, high, MEDIAN_OF_THREE);
     }
 }
 
-void print_array(int arr[], int size) {
-    for (int i = 0; i < size; i++) {
-        printf("%d ", arr[i]);
+// Parallel sample sort: a sorted random sample picks bucket splitters,
+// each thread classifies and then scatters its slice into the buckets,
+// and the threads finally claim buckets one at a time and sort them with
+// introsort. Uses one n-element buffer plus one byte per element.
+void sample_sort(int arr[], int low, int high, int num_threads) {
+    if (num_threads <= 0) {
+        num_threads = default_thread_count();
     }
-    printf("\n");
+    if (num_threads > MAX_WORKER_THREADS) {
+        num_threads = MAX_WORKER_THREADS;
+    }
+    
+    int n = high - low + 1;
+    if (num_threads == 1 || n <= PARALLEL_CUTOFF) {
+        quicksort_introsort(arr, low, high, MEDIAN_OF_THREE);
+        return;
+    }
+    
+    SampleSortContext ctx;
+    ctx.arr = arr + low;
+    ctx.n = n;
+    ctx.num_threads = num_threads;
+    ctx.num_buckets = num_threads * SAMPLE_SORT_BUCKETS_PER_THREAD;
+    if (ctx.num_buckets > SAMPLE_SORT_MAX_BUCKETS) {
+        ctx.num_buckets = SAMPLE_SORT_MAX_BUCKETS;
+    }
+    ctx.next_bucket = 0;
+    
+    int sample_size = ctx.num_buckets * SAMPLE_SORT_OVERSAMPLING;
+    int* sample = (int*)malloc(sample_size * sizeof(int));
+    ctx.buffer = (int*)malloc(n * sizeof(int));
+    ctx.bucket_of = (unsigned char*)malloc(n);
+    ctx.splitters = (int*)malloc((ctx.num_buckets - 1) * sizeof(int));
+    ctx.counts = (int*)calloc((size_t)num_threads * ctx.num_buckets, sizeof(int));
+    ctx.bucket_start = (int*)malloc((ctx.num_buckets + 1) * sizeof(int));
+    
+    if (!sample || !ctx.buffer || !ctx.bucket_of || !ctx.splitters || !ctx.counts ||
+        !ctx.bucket_start) {
+        free(sample);
+        free(ctx.buffer);
+        free(ctx.bucket_of);
+        free(ctx.splitters);
+        free(ctx.counts);
+        free(ctx.bucket_start);
+        quicksort_parallel(arr, low, high, MEDIAN_OF_THREE, num_threads);
+        return;
+    }
+    
+    // Fixed-seed xorshift keeps the sample (and timings) reproducible
+    unsigned int seed = 2463534242u;
+    for (int i = 0; i < sample_size; i++) {
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        sample[i] = ctx.arr[seed % (unsigned int)n];
+    }
+    quicksort_hybrid(sample, 0, sample_size - 1, MEDIAN_OF_THREE);
+    for (int b = 1; b < ctx.num_buckets; b++) {
+        ctx.splitters[b - 1] = sample[b * SAMPLE_SORT_OVERSAMPLING];
+    }
+    free(sample);
+    
+    run_sample_sort_phase(&ctx, SAMPLE_CLASSIFY);
+    
+    // Bucket-major prefix sum: thread t writes bucket b starting after all
+    // of bucket b's elements from threads 0..t-1
+    int offset = 0;
+    for (int b = 0; b < ctx.num_buckets; b++) {
+        ctx.bucket_start[b] = offset;
+        for (int t = 0; t < num_threads; t++) {
+            int count = ctx.counts[t * ctx.num_buckets + b];
+            ctx.counts[t * ctx.num_buckets + b] = offset;
+            offset += count;
+        }
+    }
+    ctx.bucket_start[ctx.num_buckets] = offset;
+    
+    run_sample_sort_phase(&ctx, SAMPLE_SCATTER);
+    run_sample_sort_phase(&ctx, SAMPLE_SORT_BUCKETS);
+    
+    free(ctx.buffer);
+    free(ctx.bucket_of);
+    free(ctx.splitters);
+    free(ctx.counts);
+    free(ctx.bucket_start);
 }
 
-bool is_sorted(int arr[], int size) {
-    for (int i = 1; i < size; i++) {
-        if (arr[i] < arr[i - 1]) {
-            return false;
+// Runs one phase on num_threads workers; the caller is worker 0, and any
+// worker whose thread cannot be spawned is run inline afterwards
+void run_sample_sort_phase(SampleSortContext* ctx, SampleSortPhase phase) {
+    pthread_t threads[MAX_WORKER_THREADS];
+    SampleSortArgs args[MAX_WORKER_THREADS];
+    
+    for (int i = 0; i < ctx->num_threads; i++) {
+        args[i].ctx = ctx;
+        args[i].id = i;
+        args[i].phase = phase;
+    }
+    
+    int spawned = 1;
+    for (int i = 1; i < ctx->num_threads; i++) {
+        if (pthread_create(&threads[i], NULL, sample_sort_worker, &args[i]) != 0) {
+            break;
         }
+        spawned++;
+    }
+    
+    for (int i = spawned; i < ctx->num_threads; i++) {
+        sample_sort_worker(&args[i]);
+    }
+    sample_sort_worker(&args[0]);
+    
+    for (int i = 1; i < spawned; i++) {
+        pthread_join(threads[i], NULL);
     }
-    return true;
 }
 
-void generate_test_data(int arr[], int size, const char* type) {
-    srand(time(NULL));
+void* sample_sort_worker(void* args) {
+    SampleSortArgs* worker = (SampleSortArgs*)args;
+    SampleSortContext* ctx = worker->ctx;
+    int begin = (int)((long long)ctx->n * worker->id / ctx->num_threads);
+    int end = (int)((long long)ctx->n * (worker->id + 1) / ctx->num_threads);
+    int* counts = &ctx->counts[worker->id * ctx->num_buckets];
     
-    if (strcmp(type, "random") == 0) {
-        for (int i = 0; i < size; i++) {
-            arr[i] = rand() % 1000;
-        }
-    } else if (strcmp(type, "ascending") == 0) {
-        for (int i = 0; i < size; i++) {
-            arr[i] = i;
-        }
-    } else if (strcmp(type, "descending") == 0) {
-        for (int i = 0; i < size; i++) {
-            arr[i] = size - i;
-        }
+    switch (worker->phase) {
+        case SAMPLE_CLASSIFY:
+            for (int i = begin; i < end; i++) {
+                int b = find_bucket(ctx->splitters, ctx->num_buckets - 1, ctx->arr[i]);
+                ctx->bucket_of[i] = (unsigned char)b;
+                counts[b]++;
+            }
+            break;
+            
+        case SAMPLE_SCATTER:
+            for (int i = begin; i < end; i++) {
+                ctx->buffer[counts[ctx->bucket_of[i]]++] = ctx->arr[i];
+            }
+            break;
+            
+        case SAMPLE_SORT_BUCKETS:
+            while (1) {
+                int b = __atomic_fetch_add(&ctx->next_bucket, 1, __ATOMIC_RELAXED);
+                if (b >= ctx->num_buckets) break;
+                
+                int start = ctx->bucket_start[b];
+                int count = ctx->bucket_start[b + 1] - start;
+                if (count > 1) {
+                    quicksort_introsort(ctx->buffer, start, start + count - 1, MEDIAN_OF_THREE);
+                }
+                memcpy(ctx->arr + start, ctx->buffer + start, count * sizeof(int));
+            }
+            break;
     }
+    
+    return NULL;
 }
 
-void benchmark_sorts(int size) {
-    printf("\n=== Performance Benchmark (Size: %d) ===\n", size);
+// Index of the first splitter greater than key, i.e. the key's bucket
+int find_bucket(const int splitters[], int num_splitters, int key) {
+    int lo = 0;
+    int hi = num_splitters;
     
-    int* test_data = (int*)malloc(size * sizeof(int));
-    if (!test_data) {
-        printf("Memory allocation failed!\n");
-        return;
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (splitters[mid] <= key) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
     }
     
-    const char* test_types[] = {"random", "ascending", "descending"};
-    const char* strategy_names[] = {"First", "Last", "Middle", "Median-of-3", "Random"};
+    return lo;
+}
+
+int partition(int arr[], int low, int high, PivotStrategy strategy) {
+    int pivot_index = select_pivot(arr, low, high, strategy);
     
-    for (int test_type = 0; test_type < 3; test_type++) {
-        printf("\n--- %s data ---\n", test_types[test_type]);
+    // Move pivot to end
+    swap(&arr[pivot_index], &arr[high]);
+    int pivot = arr[high];
+    
+    int i = low - 1;
+    
+    for (int j = low; j < high; j++) {
+        if (arr[j] <= pivot) {
+            i++;
+            swap(&arr[i], &arr[j]);
+        }
+    }
+    
+    swap(&arr[i + 1], &arr[high]);
+    return i + 1;
+}
+
+// Hybrid quicksort on top of partition_block. Recurses into the smaller
+// side and loops on the larger one, so stack depth stays O(log n).
+void quicksort_block(int arr[], int low, int high, PivotStrategy strategy) {
+    while (high - low + 1 > small_sort_threshold) {
+        int pivot_index = partition_block(arr, low, high, strategy);
+        
+        if (pivot_index - low < high - pivot_index) {
+            quicksort_block(arr, low, pivot_index - 1, strategy);
+            low = pivot_index + 1;
+        } else {
+            quicksort_block(arr, pivot_index + 1, high, strategy);
+            high = pivot_index - 1;
+        }
+    }
+    
+    if (low < high) {
+        small_sort(arr, low, high);
+    }
+}
+
+// Quicksort on a three-way (fat) partition: keys equal to
+// the pivot are gathered in the middle and never visited again, so inputs
+// with few distinct keys finish in close to one pass per distinct value
+void quicksort_three_way(int arr[], int low, int high, PivotStrategy strategy) {
+    while (high - low + 1 > small_sort_threshold) {
+        int lt, gt;
+        partition_three_way(arr, low, high, strategy, &lt, &gt);
+        
+        if (lt - low < high - gt) {
+            quicksort_three_way(arr, low, lt - 1, strategy);
+            low = gt + 1;
+        } else {
+            quicksort_three_way(arr, gt + 1, high, strategy);
+            high = lt - 1;
+        }
+    }
+    
+    if (low < high) {
+        small_sort(arr, low, high);
+    }
+}
+
+// Bentley-McIlroy three-way partition: a Hoare scan that parks keys equal
+// to the pivot at both ends and swaps them into the middle at the end, so
+// distinct keys cost no more than a two-way partition.
+// On return arr[low..lt-1] < pivot, arr[lt..gt] == pivot, arr[gt+1..high] > pivot
+void partition_three_way(int arr[], int low, int high, PivotStrategy strategy, int* lt, int* gt) {
+    swap(&arr[select_pivot(arr, low, high, strategy)], &arr[low]);
+    int pivot = arr[low];
+    
+    int i = low, j = high + 1;
+    int p = low, q = high + 1;
+    
+    while (1) {
+        while (arr[++i] < pivot) {
+            if (i == high) break;
+        }
+        while (pivot < arr[--j]) {
+            if (j == low) break;
+        }
+        
+        if (i == j && arr[i] == pivot) {
+            swap(&arr[++p], &arr[i]);
+        }
+        if (i >= j) break;
+        
+        swap(&arr[i], &arr[j]);
+        if (arr[i] == pivot) swap(&arr[++p], &arr[i]);
+        if (arr[j] == pivot) swap(&arr[--q], &arr[j]);
+    }
+    
+    // Move the parked equal keys from both ends into the middle
+    i = j + 1;
+    for (int k = low; k <= p; k++) {
+        swap(&arr[k], &arr[j--]);
+    }
+    for (int k = high; k >= q; k--) {
+        swap(&arr[k], &arr[i++]);
+    }
+    
+    *lt = j + 1;
+    *gt = i - 1;
+}
+
+// LSD radix sort on digit_bits-wide digits (8, 11 or 16). The sign bit is
+// flipped so negative keys order first. One pass builds the histograms for
+// every digit; digits on which all keys agree are skipped, and the scatter
+// passes ping-pong between arr and a scratch buffer.
+void radix_sort(int arr[], int low, int high, int digit_bits) {
+    if (low >= high) return;
+    
+    if (digit_bits != 8 && digit_bits != 11 && digit_bits != 16) {
+        digit_bits = 8;
+    }
+    
+    int n = high - low + 1;
+    int passes = (32 + digit_bits - 1) / digit_bits;
+    int buckets = 1 << digit_bits;
+    unsigned int mask = (unsigned int)buckets - 1;
+    
+    int* buffer = (int*)malloc(n * sizeof(int));
+    int* counts = (int*)calloc((size_t)passes * buckets, sizeof(int));
+    if (!buffer || !counts) {
+        free(buffer);
+        free(counts);
+        quicksort_introsort(arr, low, high, MEDIAN_OF_THREE);
+        return;
+    }
+    
+    int* src = arr + low;
+    int* dst = buffer;
+    
+    for (int i = 0; i < n; i++) {
+        unsigned int key = (unsigned int)src[i] ^ 0x80000000u;
+        for (int p = 0; p < passes; p++) {
+            counts[p * buckets + ((key >> (p * digit_bits)) & mask)]++;
+        }
+    }
+    
+    for (int p = 0; p < passes; p++) {
+        int* count = counts + p * buckets;
+        int shift = p * digit_bits;
+        
+        // Every key has the same digit here: the pass would be a plain copy
+        unsigned int first_key = (unsigned int)src[0] ^ 0x80000000u;
+        if (count[(first_key >> shift) & mask] == n) {
+            continue;
+        }
+        
+        int offset = 0;
+        for (int b = 0; b < buckets; b++) {
+            int c = count[b];
+            count[b] = offset;
+            offset += c;
+        }
+        
+        for (int i = 0; i < n; i++) {
+            unsigned int key = (unsigned int)src[i] ^ 0x80000000u;
+            dst[count[(key >> shift) & mask]++] = src[i];
+        }
+        
+        int* temp = src;
+        src = dst;
+        dst = temp;
+    }
+    
+    if (src != arr + low) {
+        memcpy(arr + low, src, n * sizeof(int));
+    }
+    
+    free(buffer);
+    free(counts);
+}
+
+// Adaptive merge sort (TimSort). Natural runs are detected left to right,
+// strictly descending runs are reversed in place, and runs shorter than
+// min_run are extended with binary insertion sort. Runs are merged as
+// they are pushed so that pending run lengths grow at least like the
+// Fibonacci numbers; merges gallop once one side keeps winning. Presorted,
+// reversed and append-style inputs sort in close to linear time.
+void timsort(int arr[], int low, int high) {
+    int n = high - low + 1;
+    if (n < 2) return;
+    
+    if (n < TIMSORT_MIN_MERGE) {
+        int run = timsort_count_run(arr, low, high + 1);
+        timsort_binary_insertion(arr, low, high + 1, low + run);
+        return;
+    }
+    
+    TimSortState state;
+    state.arr = arr;
+    state.tmp = (int*)malloc((n / 2 + 1) * sizeof(int));  // Largest merge copies the shorter run
+    state.min_gallop = TIMSORT_MIN_GALLOP;
+    state.stack_size = 0;
+    
+    if (!state.tmp) {
+        quicksort_introsort(arr, low, high, MEDIAN_OF_THREE);
+        return;
+    }
+    
+    int min_run = timsort_min_run(n);
+    int start = low;
+    int remaining = n;
+    
+    while (remaining > 0) {
+        int run = timsort_count_run(arr, start, high + 1);
+        
+        if (run < min_run) {
+            int forced = remaining < min_run ? remaining : min_run;
+            timsort_binary_insertion(arr, start, start + forced, start + run);
+            run = forced;
+        }
+        
+        state.run_base[state.stack_size] = start;
+        state.run_len[state.stack_size] = run;
+        state.stack_size++;
+        timsort_merge_collapse(&state);
+        
+        start += run;
+        remaining -= run;
+    }
+    
+    while (state.stack_size > 1) {
+        int k = state.stack_size - 2;
+        if (k > 0 && state.run_len[k - 1] < state.run_len[k + 1]) k--;
+        timsort_merge_at(&state, k);
+    }
+    
+    free(state.tmp);
+}
+
+// n / 2^k rounded up, for the k that puts it in [MIN_MERGE/2, MIN_MERGE],
+// so the run count is a power of two or just under one
+int timsort_min_run(int n) {
+    int extra = 0;
+    while (n >= TIMSORT_MIN_MERGE) {
+        extra |= n & 1;
+        n >>= 1;
+    }
+    return n + extra;
+}
+
+// Length of the run starting at arr[low] (end exclusive), reversing it
+// if it is strictly descending. Strictness keeps equal keys in order.
+int timsort_count_run(int arr[], int low, int end) {
+    int run_end = low + 1;
+    if (run_end == end) return 1;
+    
+    if (arr[run_end++] < arr[low]) {
+        while (run_end < end && arr[run_end] < arr[run_end - 1]) run_end++;
+        reverse_range(arr, low, run_end - 1);
+    } else {
+        while (run_end < end && arr[run_end] >= arr[run_end - 1]) run_end++;
+    }
+    
+    return run_end - low;
+}
+
+void reverse_range(int arr[], int low, int high) {
+    while (low < high) {
+        swap(&arr[low++], &arr[high--]);
+    }
+}
+
+// Sorts arr[low..end) given that arr[low..start) is already sorted
+void timsort_binary_insertion(int arr[], int low, int end, int start) {
+    for (; start < end; start++) {
+        int pivot = arr[start];
+        int left = low;
+        int right = start;
+        
+        while (left < right) {
+            int mid = left + (right - left) / 2;
+            if (pivot < arr[mid]) {
+                right = mid;
+            } else {
+                left = mid + 1;
+            }
+        }
+        
+        memmove(&arr[left + 1], &arr[left], (start - left) * sizeof(int));
+        arr[left] = pivot;
+    }
+}
+
+// Restores the run-stack invariants len[i-2] > len[i-1] + len[i] and
+// len[i-1] > len[i], checking the top four runs
+void timsort_merge_collapse(TimSortState* state) {
+    int* len = state->run_len;
+    
+    while (state->stack_size > 1) {
+        int k = state->stack_size - 2;
+        
+        if ((k > 0 && len[k - 1] <= len[k] + len[k + 1]) ||
+            (k > 1 && len[k - 2] <= len[k - 1] + len[k])) {
+            if (len[k - 1] < len[k + 1]) k--;
+        } else if (len[k] > len[k + 1]) {
+            break;
+        }
+        timsort_merge_at(state, k);
+    }
+}
+
+// Merges stack runs k and k + 1. Elements of the first run that are
+// already below the second, and of the second that are already above the
+// first, are skipped by galloping before any copying.
+void timsort_merge_at(TimSortState* state, int k) {
+    int* arr = state->arr;
+    int base1 = state->run_base[k];
+    int len1 = state->run_len[k];
+    int base2 = state->run_base[k + 1];
+    int len2 = state->run_len[k + 1];
+    
+    state->run_len[k] = len1 + len2;
+    if (k == state->stack_size - 3) {
+        state->run_base[k + 1] = state->run_base[k + 2];
+        state->run_len[k + 1] = state->run_len[k + 2];
+    }
+    state->stack_size--;
+    
+    int skip = gallop_right(arr[base2], arr, base1, len1, 0);
+    base1 += skip;
+    len1 -= skip;
+    if (len1 == 0) return;
+    
+    len2 = gallop_left(arr[base1 + len1 - 1], arr, base2, len2, len2 - 1);
+    if (len2 == 0) return;
+    
+    if (len1 <= len2) {
+        timsort_merge_lo(state, base1, len1, base2, len2);
+    } else {
+        timsort_merge_hi(state, base1, len1, base2, len2);
+    }
+}
+
+// Position in arr[base..base+len) of the leftmost element >= key,
+// searching outward from hint in exponentially growing steps
+int gallop_left(int key, int arr[], int base, int len, int hint) {
+    int last = 0;
+    int offset = 1;
+    
+    if (key > arr[base + hint]) {
+        int max_offset = len - hint;
+        while (offset < max_offset && key > arr[base + hint + offset]) {
+            last = offset;
+            offset = offset < max_offset / 2 ? offset * 2 + 1 : max_offset;
+        }
+        if (offset > max_offset) offset = max_offset;
+        last += hint;
+        offset += hint;
+    } else {
+        int max_offset = hint + 1;
+        while (offset < max_offset && key <= arr[base + hint - offset]) {
+            last = offset;
+            offset = offset < max_offset / 2 ? offset * 2 + 1 : max_offset;
+        }
+        if (offset > max_offset) offset = max_offset;
+        int temp = last;
+        last = hint - offset;
+        offset = hint - temp;
+    }
+    
+    // arr[base + last] < key <= arr[base + offset]; binary search between
+    last++;
+    while (last < offset) {
+        int mid = last + (offset - last) / 2;
+        if (key > arr[base + mid]) {
+            last = mid + 1;
+        } else {
+            offset = mid;
+        }
+    }
+    return offset;
+}
+
+// Position in arr[base..base+len) just past the rightmost element <= key
+int gallop_right(int key, int arr[], int base, int len, int hint) {
+    int last = 0;
+    int offset = 1;
+    
+    if (key < arr[base + hint]) {
+        int max_offset = hint + 1;
+        while (offset < max_offset && key < arr[base + hint - offset]) {
+            last = offset;
+            offset = offset < max_offset / 2 ? offset * 2 + 1 : max_offset;
+        }
+        if (offset > max_offset) offset = max_offset;
+        int temp = last;
+        last = hint - offset;
+        offset = hint - temp;
+    } else {
+        int max_offset = len - hint;
+        while (offset < max_offset && key >= arr[base + hint + offset]) {
+            last = offset;
+            offset = offset < max_offset / 2 ? offset * 2 + 1 : max_offset;
+        }
+        if (offset > max_offset) offset = max_offset;
+        last += hint;
+        offset += hint;
+    }
+    
+    // arr[base + last] <= key < arr[base + offset]; binary search between
+    last++;
+    while (last < offset) {
+        int mid = last + (offset - last) / 2;
+        if (key < arr[base + mid]) {
+            offset = mid;
+        } else {
+            last = mid + 1;
+        }
+    }
+    return offset;
+}
+
+// Merges adjacent runs with len1 <= len2, copying the first run to tmp
+// and filling arr from the left. Requires arr[base1] > arr[base2] and the
+// last element of run 1 to exceed every element of run 2's tail, which
+// timsort_merge_at guarantees.
+void timsort_merge_lo(TimSortState* state, int base1, int len1, int base2, int len2) {
+    int* arr = state->arr;
+    int* tmp = state->tmp;
+    memcpy(tmp, &arr[base1], len1 * sizeof(int));
+    
+    int cursor1 = 0;
+    int cursor2 = base2;
+    int dest = base1;
+    int min_gallop = state->min_gallop;
+    
+    arr[dest++] = arr[cursor2++];
+    if (--len2 == 0) {
+        memcpy(&arr[dest], &tmp[cursor1], len1 * sizeof(int));
+        return;
+    }
+    if (len1 == 1) {
+        memmove(&arr[dest], &arr[cursor2], len2 * sizeof(int));
+        arr[dest + len2] = tmp[cursor1];
+        return;
+    }
+    
+    while (1) {
+        int count1 = 0;  // Consecutive wins by run 1
+        int count2 = 0;  // Consecutive wins by run 2
+        
+        // One element at a time until one run wins min_gallop times in a row
+        do {
+            if (arr[cursor2] < tmp[cursor1]) {
+                arr[dest++] = arr[cursor2++];
+                count2++;
+                count1 = 0;
+                if (--len2 == 0) goto done;
+            } else {
+                arr[dest++] = tmp[cursor1++];
+                count1++;
+                count2 = 0;
+                if (--len1 == 1) goto done;
+            }
+        } while ((count1 | count2) < min_gallop);
+        
+        // Galloping: copy whole stretches while they stay long
+        do {
+            count1 = gallop_right(arr[cursor2], tmp, cursor1, len1, 0);
+            if (count1 != 0) {
+                memcpy(&arr[dest], &tmp[cursor1], count1 * sizeof(int));
+                dest += count1;
+                cursor1 += count1;
+                len1 -= count1;
+                if (len1 <= 1) goto done;
+            }
+            arr[dest++] = arr[cursor2++];
+            if (--len2 == 0) goto done;
+            
+            count2 = gallop_left(tmp[cursor1], arr, cursor2, len2, 0);
+            if (count2 != 0) {
+                memmove(&arr[dest], &arr[cursor2], count2 * sizeof(int));
+                dest += count2;
+                cursor2 += count2;
+                len2 -= count2;
+                if (len2 == 0) goto done;
+            }
+            arr[dest++] = tmp[cursor1++];
+            if (--len1 == 1) goto done;
+            min_gallop--;
+        } while (count1 >= TIMSORT_MIN_GALLOP || count2 >= TIMSORT_MIN_GALLOP);
+        
+        // Galloping stopped paying off; make it harder to re-enter
+        if (min_gallop < 0) min_gallop = 0;
+        min_gallop += 2;
+    }
+    
+done:
+    state->min_gallop = min_gallop < 1 ? 1 : min_gallop;
+    
+    if (len1 == 1) {
+        memmove(&arr[dest], &arr[cursor2], len2 * sizeof(int));
+        arr[dest + len2] = tmp[cursor1];
+    } else {
+        memcpy(&arr[dest], &tmp[cursor1], len1 * sizeof(int));
+    }
+}
+
+// Mirror image of timsort_merge_lo for len1 > len2: the second run goes
+// to tmp and arr is filled from the right
+void timsort_merge_hi(TimSortState* state, int base1, int len1, int base2, int len2) {
+    int* arr = state->arr;
+    int* tmp = state->tmp;
+    memcpy(tmp, &arr[base2], len2 * sizeof(int));
+    
+    int cursor1 = base1 + len1 - 1;
+    int cursor2 = len2 - 1;
+    int dest = base2 + len2 - 1;
+    int min_gallop = state->min_gallop;
+    
+    arr[dest--] = arr[cursor1--];
+    if (--len1 == 0) {
+        memcpy(&arr[dest - (len2 - 1)], tmp, len2 * sizeof(int));
+        return;
+    }
+    if (len2 == 1) {
+        dest -= len1;
+        cursor1 -= len1;
+        memmove(&arr[dest + 1], &arr[cursor1 + 1], len1 * sizeof(int));
+        arr[dest] = tmp[cursor2];
+        return;
+    }
+    
+    while (1) {
+        int count1 = 0;
+        int count2 = 0;
+        
+        do {
+            if (tmp[cursor2] < arr[cursor1]) {
+                arr[dest--] = arr[cursor1--];
+                count1++;
+                count2 = 0;
+                if (--len1 == 0) goto done;
+            } else {
+                arr[dest--] = tmp[cursor2--];
+                count2++;
+                count1 = 0;
+                if (--len2 == 1) goto done;
+            }
+        } while ((count1 | count2) < min_gallop);
+        
+        do {
+            count1 = len1 - gallop_right(tmp[cursor2], arr, base1, len1, len1 - 1);
+            if (count1 != 0) {
+                dest -= count1;
+                cursor1 -= count1;
+                len1 -= count1;
+                memmove(&arr[dest + 1], &arr[cursor1 + 1], count1 * sizeof(int));
+                if (len1 == 0) goto done;
+            }
+            arr[dest--] = tmp[cursor2--];
+            if (--len2 == 1) goto done;
+            
+            count2 = len2 - gallop_left(arr[cursor1], tmp, 0, len2, len2 - 1);
+            if (count2 != 0) {
+                dest -= count2;
+                cursor2 -= count2;
+                len2 -= count2;
+                memcpy(&arr[dest + 1], &tmp[cursor2 + 1], count2 * sizeof(int));
+                if (len2 <= 1) goto done;
+            }
+            arr[dest--] = arr[cursor1--];
+            if (--len1 == 0) goto done;
+            min_gallop--;
+        } while (count1 >= TIMSORT_MIN_GALLOP || count2 >= TIMSORT_MIN_GALLOP);
+        
+        if (min_gallop < 0) min_gallop = 0;
+        min_gallop += 2;
+    }
+    
+done:
+    state->min_gallop = min_gallop < 1 ? 1 : min_gallop;
+    
+    if (len2 == 1) {
+        dest -= len1;
+        cursor1 -= len1;
+        memmove(&arr[dest + 1], &arr[cursor1 + 1], len1 * sizeof(int));
+        arr[dest] = tmp[cursor2];
+    } else {
+        memcpy(&arr[dest - (len2 - 1)], tmp, len2 * sizeof(int));
+    }
+}
+
+// Pattern-defeating introsort: block partitioning with a budget of
+// floor(log2 n) bad partitions (smaller side under 1/8 of the range).
+// Each bad partition shuffles the positions the pivot strategies sample;
+// once the budget is spent the range is finished with heap sort, so the
+// worst case is O(n log n) whatever the pivot strategy or input.
+void quicksort_introsort(int arr[], int low, int high, PivotStrategy strategy) {
+    if (low < high) {
+        introsort_loop(arr, low, high, strategy, floor_log2(high - low + 1));
+    }
+}
+
+void introsort_loop(int arr[], int low, int high, PivotStrategy strategy, int bad_allowed) {
+    while (high - low + 1 > small_sort_threshold) {
+        int size = high - low + 1;
+        int pivot_index = partition_block(arr, low, high, strategy);
+        int left_size = pivot_index - low;
+        int right_size = high - pivot_index;
+        
+        if ((left_size < right_size ? left_size : right_size) < size / 8) {
+            if (--bad_allowed <= 0) {
+                heap_sort_range(arr, low, high);
+                return;
+            }
+            break_patterns(arr, low, pivot_index - 1);
+            break_patterns(arr, pivot_index + 1, high);
+        }
+        
+        // Recurse into the smaller side so stack depth stays O(log n)
+        if (left_size < right_size) {
+            introsort_loop(arr, low, pivot_index - 1, strategy, bad_allowed);
+            low = pivot_index + 1;
+        } else {
+            introsort_loop(arr, pivot_index + 1, high, strategy, bad_allowed);
+            high = pivot_index - 1;
+        }
+    }
+    
+    if (low < high) {
+        small_sort(arr, low, high);
+    }
+}
+
+// Swap the first, middle and last elements (where every pivot strategy
+// looks) with random elements of the range
+void break_patterns(int arr[], int low, int high) {
+    int size = high - low + 1;
+    if (size <= INSERTION_SORT_THRESHOLD) return;
+    
+    int positions[] = {low, low + size / 2, high};
+    for (int k = 0; k < 3; k++) {
+        swap(&arr[positions[k]], &arr[low + rand() % size]);
+    }
+}
+
+// Ascending heap sort of arr[low..high]; the same max-heap algorithm as
+// heap_sort_ascending in HeapSort_PriorityQueue_Optimized.c, with an
+// iterative sift so the fallback never adds recursion depth
+void heap_sort_range(int arr[], int low, int high) {
+    int* base = arr + low;
+    int n = high - low + 1;
+    
+    for (int i = n / 2 - 1; i >= 0; i--) {
+        sift_down_range(base, n, i);
+    }
+    
+    for (int i = n - 1; i > 0; i--) {
+        swap(&base[0], &base[i]);
+        sift_down_range(base, i, 0);
+    }
+}
+
+void sift_down_range(int arr[], int n, int root) {
+    int value = arr[root];
+    
+    while (2 * root + 1 < n) {
+        int child = 2 * root + 1;
+        if (child + 1 < n && arr[child + 1] > arr[child]) {
+            child++;
+        }
+        if (arr[child] <= value) {
+            break;
+        }
+        arr[root] = arr[child];
+        root = child;
+    }
+    
+    arr[root] = value;
+}
+
+int floor_log2(int n) {
+    int log = 0;
+    while (n > 1) {
+        n >>= 1;
+        log++;
+    }
+    return log;
+}
+
+// BlockQuicksort-style partition. Both ends are scanned a block at a time,
+// recording the offsets of misplaced elements with a branch-free compare;
+// the recorded pairs are then swapped in bulk. Elements equal to the pivot
+// are flagged on both sides, so duplicates end up split evenly.
+int partition_block(int arr[], int low, int high, PivotStrategy strategy) {
+    int pivot_index = select_pivot(arr, low, high, strategy);
+    
+    swap(&arr[pivot_index], &arr[high]);
+    int pivot = arr[high];
+    
+    unsigned char offsets_left[BLOCK_PARTITION_SIZE];
+    unsigned char offsets_right[BLOCK_PARTITION_SIZE];
+    int num_left = 0, num_right = 0;
+    int start_left = 0, start_right = 0;
+    
+    // Invariant: arr[low..l-1] <= pivot and arr[r+1..high-1] >= pivot
+    int l = low;
+    int r = high - 1;
+    
+    while (r - l + 1 > 2 * BLOCK_PARTITION_SIZE) {
+        if (num_left == 0) {
+            start_left = 0;
+            for (int i = 0; i < BLOCK_PARTITION_SIZE; i++) {
+                offsets_left[num_left] = (unsigned char)i;
+                num_left += (arr[l + i] >= pivot);
+            }
+        }
+        if (num_right == 0) {
+            start_right = 0;
+            for (int i = 0; i < BLOCK_PARTITION_SIZE; i++) {
+                offsets_right[num_right] = (unsigned char)i;
+                num_right += (arr[r - i] <= pivot);
+            }
+        }
+        
+        int num = num_left < num_right ? num_left : num_right;
+        for (int k = 0; k < num; k++) {
+            int a = l + offsets_left[start_left + k];
+            int b = r - offsets_right[start_right + k];
+            int temp = arr[a];
+            arr[a] = arr[b];
+            arr[b] = temp;
+        }
+        
+        num_left -= num;
+        num_right -= num;
+        start_left += num;
+        start_right += num;
+        
+        if (num_left == 0) l += BLOCK_PARTITION_SIZE;
+        if (num_right == 0) r -= BLOCK_PARTITION_SIZE;
+    }
+    
+    // Finish the remaining window (at most two blocks) with a Hoare scan;
+    // any half-consumed block is still inside [l, r], so the invariant holds
+    while (1) {
+        while (l <= r && arr[l] < pivot) l++;
+        while (l <= r && arr[r] > pivot) r--;
+        if (l >= r) break;
+        
+        int temp = arr[l];
+        arr[l] = arr[r];
+        arr[r] = temp;
+        l++;
+        r--;
+    }
+    
+    swap(&arr[l], &arr[high]);
+    return l;
+}
+
+int select_pivot(int arr[], int low, int high, PivotStrategy strategy) {
+    switch (strategy) {
+        case FIRST_ELEMENT:
+            return low;
+        case LAST_ELEMENT:
+            return high;
+        case MIDDLE_ELEMENT:
+            return low + (high - low) / 2;
+        case MEDIAN_OF_THREE:
+            return median_of_three(arr, low, high);
+        case RANDOM_ELEMENT:
+            return low + rand() % (high - low + 1);
+        default:
+            return high;
+    }
+}
+
+int median_of_three(int arr[], int low, int high) {
+    int mid = low + (high - low) / 2;
+    
+    if (arr[low] > arr[mid]) swap(&arr[low], &arr[mid]);
+    if (arr[mid] > arr[high]) swap(&arr[mid], &arr[high]);
+    if (arr[low] > arr[mid]) swap(&arr[low], &arr[mid]);
+    
+    return mid;
+}
+
+void insertion_sort(int arr[], int low, int high) {
+    for (int i = low + 1; i <= high; i++) {
+        int key = arr[i];
+        int j = i - 1;
+        
+        while (j >= low && arr[j] > key) {
+            arr[j + 1] = arr[j];
+            j--;
+        }
+        arr[j + 1] = key;
+    }
+}
+
+// Base case for small subarrays. Ranges of up to SORTING_NETWORK_SIZE
+// elements are padded with INT_MAX to 8 or 16 and run through a bitonic
+// sorting network: a fixed compare-exchange sequence with no
+// data-dependent branches. Longer ranges (a cutoff tuned above 16) and
+// SMALL_SORT_INSERTION mode use insertion sort.
+void small_sort(int arr[], int low, int high) {
+    int n = high - low + 1;
+    if (n <= 1) return;
+    
+    if (small_sort_mode == SMALL_SORT_INSERTION || n > SORTING_NETWORK_SIZE) {
+        insertion_sort(arr, low, high);
+        return;
+    }
+    
+    int v[SORTING_NETWORK_SIZE];
+    int width = n <= 8 ? 8 : 16;
+    
+    memcpy(v, arr + low, n * sizeof(int));
+    for (int i = n; i < width; i++) {
+        v[i] = INT_MAX;
+    }
+    
+#ifdef SIMD_SORT_AVAILABLE
+    if (small_sort_mode == SMALL_SORT_NETWORK_SIMD && simd_sort_supported()) {
+        if (width == 8) {
+            sort_network_8_avx2(v);
+        } else {
+            sort_network_16_avx2(v);
+        }
+    } else {
+        sort_network_scalar(v, width);
+    }
+#else
+    sort_network_scalar(v, width);
+#endif
+    
+    memcpy(arr + low, v, n * sizeof(int));
+}
+
+// Bitonic sorting network over v[0..n-1], n a power of two. The min/max
+// selects compile to conditional moves rather than branches.
+void sort_network_scalar(int v[], int n) {
+    for (int k = 2; k <= n; k <<= 1) {
+        for (int j = k >> 1; j > 0; j >>= 1) {
+            for (int i = 0; i < n; i++) {
+                int l = i ^ j;
+                if (l > i) {
+                    int a = v[i];
+                    int b = v[l];
+                    int lo = a < b ? a : b;
+                    int hi = a < b ? b : a;
+                    bool ascending = (i & k) == 0;
+                    v[i] = ascending ? lo : hi;
+                    v[l] = ascending ? hi : lo;
+                }
+            }
+        }
+    }
+}
+
+bool simd_sort_supported(void) {
+#ifdef SIMD_SORT_AVAILABLE
+    return __builtin_cpu_supports("avx2");
+#else
+    return false;
+#endif
+}
+
+#ifdef SIMD_SORT_AVAILABLE
+// One bitonic stage in an AVX2 register: compare each lane with its
+// partner (given by the permutation), then blend min/max per lane
+#define AVX2_STAGE(v, permuted, max_lanes)                        \
+    do {                                                          \
+        __m256i partner_ = (permuted);                            \
+        __m256i lo_ = _mm256_min_epi32((v), partner_);            \
+        __m256i hi_ = _mm256_max_epi32((v), partner_);            \
+        (v) = _mm256_blend_epi32(lo_, hi_, (max_lanes));          \
+    } while (0)
+
+#define SWAP_PAIRS(v) _mm256_shuffle_epi32((v), _MM_SHUFFLE(2, 3, 0, 1))
+#define SWAP_QUADS(v) _mm256_shuffle_epi32((v), _MM_SHUFFLE(1, 0, 3, 2))
+#define SWAP_HALVES(v) _mm256_permute2x128_si256((v), (v), 1)
+
+__attribute__((target("avx2")))
+void sort_network_8_avx2(int v[]) {
+    __m256i a = _mm256_loadu_si256((const __m256i*)v);
+    
+    AVX2_STAGE(a, SWAP_PAIRS(a), 0x66);
+    AVX2_STAGE(a, SWAP_QUADS(a), 0x3c);
+    AVX2_STAGE(a, SWAP_PAIRS(a), 0x5a);
+    AVX2_STAGE(a, SWAP_HALVES(a), 0xf0);
+    AVX2_STAGE(a, SWAP_QUADS(a), 0xcc);
+    AVX2_STAGE(a, SWAP_PAIRS(a), 0xaa);
+    
+    _mm256_storeu_si256((__m256i*)v, a);
+}
+
+// Sorts v[0..7] ascending and v[8..15] descending in separate registers,
+// merges them with one cross-register min/max, then finishes both halves
+__attribute__((target("avx2")))
+void sort_network_16_avx2(int v[]) {
+    __m256i a = _mm256_loadu_si256((const __m256i*)v);
+    __m256i b = _mm256_loadu_si256((const __m256i*)(v + 8));
+    
+    AVX2_STAGE(a, SWAP_PAIRS(a), 0x66);
+    AVX2_STAGE(b, SWAP_PAIRS(b), 0x66);
+    AVX2_STAGE(a, SWAP_QUADS(a), 0x3c);
+    AVX2_STAGE(b, SWAP_QUADS(b), 0x3c);
+    AVX2_STAGE(a, SWAP_PAIRS(a), 0x5a);
+    AVX2_STAGE(b, SWAP_PAIRS(b), 0x5a);
+    AVX2_STAGE(a, SWAP_HALVES(a), 0xf0);
+    AVX2_STAGE(b, SWAP_HALVES(b), 0x0f);
+    AVX2_STAGE(a, SWAP_QUADS(a), 0xcc);
+    AVX2_STAGE(b, SWAP_QUADS(b), 0x33);
+    AVX2_STAGE(a, SWAP_PAIRS(a), 0xaa);
+    AVX2_STAGE(b, SWAP_PAIRS(b), 0x55);
+    
+    __m256i lo = _mm256_min_epi32(a, b);
+    __m256i hi = _mm256_max_epi32(a, b);
+    a = lo;
+    b = hi;
+    
+    AVX2_STAGE(a, SWAP_HALVES(a), 0xf0);
+    AVX2_STAGE(b, SWAP_HALVES(b), 0xf0);
+    AVX2_STAGE(a, SWAP_QUADS(a), 0xcc);
+    AVX2_STAGE(b, SWAP_QUADS(b), 0xcc);
+    AVX2_STAGE(a, SWAP_PAIRS(a), 0xaa);
+    AVX2_STAGE(b, SWAP_PAIRS(b), 0xaa);
+    
+    _mm256_storeu_si256((__m256i*)v, a);
+    _mm256_storeu_si256((__m256i*)(v + 8), b);
+}
+#endif
+
+void swap(int* a, int* b) {
+    if (a != b) {
+        int temp = *a;
+        *a = *b;
+        *b = temp;
+    }
+}
+
+void print_array(int arr[], int size) {
+    for (int i = 0; i < size; i++) {
+        printf("%d ", arr[i]);
+    }
+    printf("\n");
+}
+
+bool is_sorted(int arr[], int size) {
+    for (int i = 1; i < size; i++) {
+        if (arr[i] < arr[i - 1]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Fills arr from the current rand() stream; callers that need
+// reproducible data seed it first with srand()
+void generate_test_data(int arr[], int size, const char* type) {
+    if (strcmp(type, "random") == 0) {
+        for (int i = 0; i < size; i++) {
+            arr[i] = rand() % 1000;
+        }
+    } else if (strcmp(type, "ascending") == 0) {
+        for (int i = 0; i < size; i++) {
+            arr[i] = i;
+        }
+    } else if (strcmp(type, "descending") == 0) {
+        for (int i = 0; i < size; i++) {
+            arr[i] = size - i;
+        }
+    } else if (strcmp(type, "full_range") == 0) {
+        for (int i = 0; i < size; i++) {
+            arr[i] = (int)(((unsigned int)rand() << 16) ^ (unsigned int)rand());
+        }
+    } else if (strcmp(type, "few_unique") == 0) {
+        for (int i = 0; i < size; i++) {
+            arr[i] = rand() % 16;
+        }
+    } else if (strcmp(type, "nearly_sorted") == 0) {
+        // Ascending with 1% of positions swapped at random, like a mostly
+        // ordered append log with some late arrivals
+        for (int i = 0; i < size; i++) {
+            arr[i] = i;
+        }
+        for (int k = 0; k < size / 100; k++) {
+            swap(&arr[rand() % size], &arr[rand() % size]);
+        }
+    }
+}
+
+// Quick single-run comparison for the menu; Sort_Benchmark.c is the
+// repeatable harness with warm-up, multiple trials and CSV/JSON output
+void benchmark_sorts(int size) {
+    printf("\n=== Performance Benchmark (Size: %d) ===\n", size);
+    
+    int* test_data = (int*)malloc(size * sizeof(int));
+    if (!test_data) {
+        printf("Memory allocation failed!\n");
+        return;
+    }
+    
+    const char* test_types[] = {"random", "ascending", "descending", "few_unique"};
+    const char* strategy_names[] = {"First", "Last", "Middle", "Median-of-3", "Random"};
+    
+    for (int test_type = 0; test_type < 4; test_type++) {
+        printf("\n--- %s data ---\n", test_types[test_type]);
         
         for (int strat = 0; strat < 5; strat++) {
+            srand(BENCHMARK_SEED);
             generate_test_data(test_data, size, test_types[test_type]);
             
-            clock_t start = clock();
+            double start = get_wall_time();
             quicksort_hybrid(test_data, 0, size - 1, (PivotStrategy)strat);
-            clock_t end = clock();
-            
-            double time_taken = ((double)(end - start)) / CLOCKS_PER_SEC;
+            double time_taken = get_wall_time() - start;
             printf("%s pivot: %f seconds - %s\n", 
                    strategy_names[strat], time_taken,
                    is_sorted(test_data, size) ? "✓" : "✗");
         }
+        
+        srand(BENCHMARK_SEED);
+        generate_test_data(test_data, size, test_types[test_type]);
+        
+        double start = get_wall_time();
+        quicksort_three_way(test_data, 0, size - 1, MEDIAN_OF_THREE);
+        double time_taken = get_wall_time() - start;
+        printf("Three-way (Median-of-3): %f seconds - %s\n",
+               time_taken, is_sorted(test_data, size) ? "✓" : "✗");
+    }
+    
+    free(test_data);
+}
+
+double get_wall_time(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+int default_thread_count(void) {
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    if (cpus < 1) return 1;
+    if (cpus > MAX_WORKER_THREADS) return MAX_WORKER_THREADS;
+    return (int)cpus;
+}
+
+// True if equal keys kept their original (id) order
+bool is_stable_by_key(Record records[], int size) {
+    for (int i = 1; i < size; i++) {
+        if (records[i].key < records[i - 1].key) return false;
+        if (records[i].key == records[i - 1].key && records[i].id < records[i - 1].id) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Sorts records with many repeated keys (id = original position) by key
+// and checks that equal keys keep their input order
+void check_stable_sort(int size, int num_threads) {
+    Record* stable = (Record*)malloc(size * sizeof(Record));
+    Record* unstable = (Record*)malloc(size * sizeof(Record));
+    if (!stable || !unstable) {
+        printf("Memory allocation failed!\n");
+        free(stable);
+        free(unstable);
+        return;
+    }
+    
+    if (num_threads <= 0) {
+        num_threads = default_thread_count();
+    }
+    
+    for (int i = 0; i < size; i++) {
+        stable[i].key = rand() % 100;
+        stable[i].id = i;
+        stable[i].value = (double)i;
+    }
+    memcpy(unstable, stable, size * sizeof(Record));
+    
+    double start = get_wall_time();
+    bool ok = record_stable_sort(stable, 0, size - 1, num_threads);
+    double stable_time = get_wall_time() - start;
+    
+    start = get_wall_time();
+    record_sort(unstable, 0, size - 1);
+    double unstable_time = get_wall_time() - start;
+    
+    printf("\nRecords with 100 distinct keys:\n");
+    if (!ok) {
+        printf("Stable merge sort: scratch allocation failed\n");
+    } else {
+        printf("Stable merge sort:   %f seconds, stable: %s\n", stable_time,
+               is_stable_by_key(stable, size) ? "Yes" : "No");
+    }
+    printf("Introsort (generic): %f seconds, stable: %s\n", unstable_time,
+           is_stable_by_key(unstable, size) ? "Yes" : "No");
+    
+    free(stable);
+    free(unstable);
+}
+
+// Task deque implementation
+bool init_deque(TaskDeque* deque) {
+    deque->capacity = 64;
+    deque->head = 0;
+    deque->tail = 0;
+    deque->tasks = (StackFrame*)malloc(deque->capacity * sizeof(StackFrame));
+    if (!deque->tasks) {
+        return false;
+    }
+    if (pthread_mutex_init(&deque->lock, NULL) != 0) {
+        free(deque->tasks);
+        return false;
+    }
+    return true;
+}
+
+void free_deque(TaskDeque* deque) {
+    pthread_mutex_destroy(&deque->lock);
+    free(deque->tasks);
+}
+
+bool push_task(TaskDeque* deque, int low, int high) {
+    pthread_mutex_lock(&deque->lock);
+    
+    if (deque->tail == deque->capacity) {
+        if (deque->head > 0) {
+            // Reclaim the slots freed by thieves before growing
+            memmove(deque->tasks, deque->tasks + deque->head,
+                    (deque->tail - deque->head) * sizeof(StackFrame));
+            deque->tail -= deque->head;
+            deque->head = 0;
+        } else {
+            StackFrame* grown = (StackFrame*)realloc(deque->tasks,
+                                    2 * deque->capacity * sizeof(StackFrame));
+            if (!grown) {
+                pthread_mutex_unlock(&deque->lock);
+                return false;
+            }
+            deque->tasks = grown;
+            deque->capacity *= 2;
+        }
+    }
+    
+    deque->tasks[deque->tail].low = low;
+    deque->tasks[deque->tail].high = high;
+    deque->tail++;
+    
+    pthread_mutex_unlock(&deque->lock);
+    return true;
+}
+
+bool pop_task(TaskDeque* deque, int* low, int* high) {
+    bool found = false;
+    pthread_mutex_lock(&deque->lock);
+    
+    if (deque->tail > deque->head) {
+        deque->tail--;
+        *low = deque->tasks[deque->tail].low;
+        *high = deque->tasks[deque->tail].high;
+        found = true;
+        if (deque->tail == deque->head) {
+            deque->head = deque->tail = 0;
+        }
+    }
+    
+    pthread_mutex_unlock(&deque->lock);
+    return found;
+}
+
+bool steal_task(TaskDeque* deque, int* low, int* high) {
+    bool found = false;
+    pthread_mutex_lock(&deque->lock);
+    
+    if (deque->tail > deque->head) {
+        *low = deque->tasks[deque->head].low;
+        *high = deque->tasks[deque->head].high;
+        deque->head++;
+        found = true;
+        if (deque->tail == deque->head) {
+            deque->head = deque->tail = 0;
+        }
+    }
+    
+    pthread_mutex_unlock(&deque->lock);
+    return found;
+}
+
+void benchmark_partition_schemes(int size) {
+    printf("\n=== Partition Scheme Benchmark (Size: %d, Median-of-3 pivot) ===\n", size);
+    
+    int* original = (int*)malloc(size * sizeof(int));
+    int* test_data = (int*)malloc(size * sizeof(int));
+    if (!original || !test_data) {
+        printf("Memory allocation failed!\n");
+        free(original);
+        free(test_data);
+        return;
+    }
+    
+    const char* test_types[] = {"random", "ascending", "descending", "few_unique"};
+    int num_types = sizeof(test_types) / sizeof(test_types[0]);
+    
+    printf("%-12s %-14s %-14s %-14s %-10s\n", "Data", "Lomuto (s)", "Block (s)", "Three-way (s)", "Block speedup");
+    printf("%-12s %-14s %-14s %-14s %-10s\n", "----", "----------", "---------", "-------------", "-------------");
+    
+    for (int t = 0; t < num_types; t++) {
+        generate_test_data(original, size, test_types[t]);
+        
+        memcpy(test_data, original, size * sizeof(int));
+        double start = get_wall_time();
+        quicksort_hybrid(test_data, 0, size - 1, MEDIAN_OF_THREE);
+        double lomuto_time = get_wall_time() - start;
+        bool lomuto_ok = is_sorted(test_data, size);
+        
+        memcpy(test_data, original, size * sizeof(int));
+        start = get_wall_time();
+        quicksort_block(test_data, 0, size - 1, MEDIAN_OF_THREE);
+        double block_time = get_wall_time() - start;
+        bool block_ok = is_sorted(test_data, size);
+        
+        memcpy(test_data, original, size * sizeof(int));
+        start = get_wall_time();
+        quicksort_three_way(test_data, 0, size - 1, MEDIAN_OF_THREE);
+        double three_way_time = get_wall_time() - start;
+        bool three_way_ok = is_sorted(test_data, size);
+        
+        printf("%-12s %-14.6f %-14.6f %-14.6f %.2fx %s\n", test_types[t],
+               lomuto_time, block_time, three_way_time,
+               block_time > 0 ? lomuto_time / block_time : 0.0,
+               lomuto_ok && block_ok && three_way_ok ? "✓" : "✗");
+    }
+    
+    free(original);
+    free(test_data);
+}
+
+// Runs introsort with every pivot strategy on the inputs that push the
+// plain quicksorts into quadratic time (sorted input with first/last pivot)
+void benchmark_introsort(int size) {
+    printf("\n=== Introsort Worst-Case Benchmark (Size: %d) ===\n", size);
+    
+    int* test_data = (int*)malloc(size * sizeof(int));
+    if (!test_data) {
+        printf("Memory allocation failed!\n");
+        return;
+    }
+    
+    const char* test_types[] = {"random", "ascending", "descending", "few_unique"};
+    const char* strategy_names[] = {"First", "Last", "Middle", "Median-of-3", "Random"};
+    int num_types = sizeof(test_types) / sizeof(test_types[0]);
+    
+    for (int t = 0; t < num_types; t++) {
+        printf("\n--- %s data ---\n", test_types[t]);
+        
+        for (int strat = 0; strat < 5; strat++) {
+            generate_test_data(test_data, size, test_types[t]);
+            
+            double start = get_wall_time();
+            quicksort_introsort(test_data, 0, size - 1, (PivotStrategy)strat);
+            double time_taken = get_wall_time() - start;
+            
+            printf("%s pivot: %f seconds - %s\n",
+                   strategy_names[strat], time_taken,
+                   is_sorted(test_data, size) ? "✓" : "✗");
+        }
+    }
+    
+    free(test_data);
+}
+
+// TimSort against the quicksorts on presorted and unsorted inputs
+void benchmark_adaptive(int size) {
+    printf("\n=== Adaptive Sort Benchmark (Size: %d) ===\n", size);
+    
+    int* original = (int*)malloc(size * sizeof(int));
+    int* test_data = (int*)malloc(size * sizeof(int));
+    if (!original || !test_data) {
+        printf("Memory allocation failed!\n");
+        free(original);
+        free(test_data);
+        return;
+    }
+    
+    // few_unique is left out: Lomuto-based hybrid is quadratic on it
+    const char* test_types[] = {"ascending", "descending", "nearly_sorted",
+                                "full_range", "random"};
+    int num_types = sizeof(test_types) / sizeof(test_types[0]);
+    
+    printf("%-14s %-12s %-12s %-12s %s\n", "Data", "Hybrid (s)", "Introsort", "TimSort", "Sorted");
+    
+    for (int t = 0; t < num_types; t++) {
+        srand(BENCHMARK_SEED);
+        generate_test_data(original, size, test_types[t]);
+        double times[3];
+        bool all_sorted = true;
+        
+        for (int k = 0; k < 3; k++) {
+            memcpy(test_data, original, size * sizeof(int));
+            double start = get_wall_time();
+            switch (k) {
+                case 0: quicksort_hybrid(test_data, 0, size - 1, MEDIAN_OF_THREE); break;
+                case 1: quicksort_introsort(test_data, 0, size - 1, MEDIAN_OF_THREE); break;
+                case 2: timsort(test_data, 0, size - 1); break;
+            }
+            times[k] = get_wall_time() - start;
+            all_sorted = all_sorted && is_sorted(test_data, size);
+        }
+        
+        printf("%-14s %-12.6f %-12.6f %-12.6f %s\n", test_types[t],
+               times[0], times[1], times[2], all_sorted ? "✓" : "✗");
+    }
+    
+    free(original);
+    free(test_data);
+}
+
+// Compares radix sort digit widths with the comparison sorts across sizes,
+// on full 32-bit keys so no radix pass can be skipped
+void benchmark_radix(void) {
+    int sizes[] = {1000, 10000, 100000, 1000000, 10000000};
+    int num_sizes = sizeof(sizes) / sizeof(sizes[0]);
+    
+    printf("\n=== Radix Sort vs Comparison Sorts (full-range keys) ===\n");
+    printf("%-10s %-12s %-12s %-12s %-12s %-12s\n",
+           "Size", "Hybrid (s)", "Introsort", "Radix-8", "Radix-11", "Radix-16");
+    
+    for (int s = 0; s < num_sizes; s++) {
+        int size = sizes[s];
+        int* original = (int*)malloc(size * sizeof(int));
+        int* test_data = (int*)malloc(size * sizeof(int));
+        if (!original || !test_data) {
+            printf("Memory allocation failed for size %d\n", size);
+            free(original);
+            free(test_data);
+            continue;
+        }
+        
+        generate_test_data(original, size, "full_range");
+        double times[5];
+        bool all_sorted = true;
+        
+        for (int k = 0; k < 5; k++) {
+            memcpy(test_data, original, size * sizeof(int));
+            double start = get_wall_time();
+            switch (k) {
+                case 0: quicksort_hybrid(test_data, 0, size - 1, MEDIAN_OF_THREE); break;
+                case 1: quicksort_introsort(test_data, 0, size - 1, MEDIAN_OF_THREE); break;
+                case 2: radix_sort(test_data, 0, size - 1, 8); break;
+                case 3: radix_sort(test_data, 0, size - 1, 11); break;
+                case 4: radix_sort(test_data, 0, size - 1, 16); break;
+            }
+            times[k] = get_wall_time() - start;
+            all_sorted = all_sorted && is_sorted(test_data, size);
+        }
+        
+        printf("%-10d %-12.6f %-12.6f %-12.6f %-12.6f %-12.6f %s\n", size,
+               times[0], times[1], times[2], times[3], times[4],
+               all_sorted ? "✓" : "✗");
+        
+        free(original);
+        free(test_data);
+    }
+}
+
+int compare_records(const void* a, const void* b) {
+    int key_a = ((const Record*)a)->key;
+    int key_b = ((const Record*)b)->key;
+    return (key_a > key_b) - (key_a < key_b);
+}
+
+// Sorts records by key three ways: in place with the inlined generic sort,
+// with qsort() and a comparator, and by sorting key/index pairs and then
+// gathering the records into a second array
+void benchmark_generic_sort(int size) {
+    printf("\n=== Record Sort Benchmark (%d records of %zu bytes) ===\n",
+           size, sizeof(Record));
+    
+    Record* original = (Record*)malloc(size * sizeof(Record));
+    Record* records = (Record*)malloc(size * sizeof(Record));
+    Record* gathered = (Record*)malloc(size * sizeof(Record));
+    KeyIndex* pairs = (KeyIndex*)malloc(size * sizeof(KeyIndex));
+    
+    if (!original || !records || !gathered || !pairs) {
+        printf("Memory allocation failed!\n");
+        free(original);
+        free(records);
+        free(gathered);
+        free(pairs);
+        return;
+    }
+    
+    for (int i = 0; i < size; i++) {
+        original[i].key = rand();
+        original[i].id = i;
+        original[i].value = (double)i * 0.5;
+    }
+    
+    memcpy(records, original, size * sizeof(Record));
+    double start = get_wall_time();
+    record_sort(records, 0, size - 1);
+    double generic_time = get_wall_time() - start;
+    bool generic_ok = record_is_sorted(records, size);
+    
+    memcpy(records, original, size * sizeof(Record));
+    start = get_wall_time();
+    qsort(records, size, sizeof(Record), compare_records);
+    double qsort_time = get_wall_time() - start;
+    bool qsort_ok = record_is_sorted(records, size);
+    
+    start = get_wall_time();
+    for (int i = 0; i < size; i++) {
+        pairs[i].key = original[i].key;
+        pairs[i].index = i;
+    }
+    key_index_sort(pairs, 0, size - 1);
+    for (int i = 0; i < size; i++) {
+        gathered[i] = original[pairs[i].index];
+    }
+    double gather_time = get_wall_time() - start;
+    bool gather_ok = record_is_sorted(gathered, size);
+    
+    printf("Generic in-place sort:  %f seconds - %s\n", generic_time, generic_ok ? "✓" : "✗");
+    printf("qsort with comparator:  %f seconds - %s\n", qsort_time, qsort_ok ? "✓" : "✗");
+    printf("Key/index sort+gather:  %f seconds - %s\n", gather_time, gather_ok ? "✓" : "✗");
+    
+    free(original);
+    free(records);
+    free(gathered);
+    free(pairs);
+}
+
+// Times the base cases on a stream of small random chunks, then the full
+// hybrid quicksort with each base case at several cutoffs
+void benchmark_small_sort(void) {
+    const int total = 1 << 20;
+    const char* mode_names[] = {"Insertion", "Network", "Network+SIMD"};
+    SmallSortMode saved_mode = small_sort_mode;
+    int saved_threshold = small_sort_threshold;
+    
+    int* original = (int*)malloc(total * sizeof(int));
+    int* test_data = (int*)malloc(total * sizeof(int));
+    if (!original || !test_data) {
+        printf("Memory allocation failed!\n");
+        free(original);
+        free(test_data);
+        return;
+    }
+    
+    srand(BENCHMARK_SEED);
+    generate_test_data(original, total, "full_range");
+    
+    printf("\n=== Small-Partition Base Case (%d elements, AVX2 %s) ===\n",
+           total, simd_sort_supported() ? "available" : "not available");
+    printf("%-8s %-14s %-14s %-14s\n", "Chunk", mode_names[0], mode_names[1], mode_names[2]);
+    
+    int chunk_sizes[] = {4, 8, 12, 16};
+    for (int c = 0; c < 4; c++) {
+        int chunk = chunk_sizes[c];
+        double times[3];
+        bool ok = true;
+        
+        for (int mode = 0; mode < 3; mode++) {
+            small_sort_mode = (SmallSortMode)mode;
+            memcpy(test_data, original, total * sizeof(int));
+            
+            double start = get_wall_time();
+            for (int low = 0; low + chunk <= total; low += chunk) {
+                small_sort(test_data, low, low + chunk - 1);
+            }
+            times[mode] = get_wall_time() - start;
+            
+            for (int low = 0; low + chunk <= total; low += chunk) {
+                ok = ok && is_sorted(test_data + low, chunk);
+            }
+        }
+        
+        printf("%-8d %-14.6f %-14.6f %-14.6f %s\n", chunk,
+               times[0], times[1], times[2], ok ? "✓" : "✗");
+    }
+    
+    printf("\nquicksort_hybrid on %d full-range keys:\n", total);
+    printf("%-8s %-14s %-14s %-14s\n", "Cutoff", mode_names[0], mode_names[1], mode_names[2]);
+    
+    int cutoffs[] = {8, 10, 12, 16};
+    for (int c = 0; c < 4; c++) {
+        double times[3];
+        bool ok = true;
+        
+        small_sort_threshold = cutoffs[c];
+        for (int mode = 0; mode < 3; mode++) {
+            small_sort_mode = (SmallSortMode)mode;
+            memcpy(test_data, original, total * sizeof(int));
+            
+            double start = get_wall_time();
+            quicksort_hybrid(test_data, 0, total - 1, MEDIAN_OF_THREE);
+            times[mode] = get_wall_time() - start;
+            ok = ok && is_sorted(test_data, total);
+        }
+        
+        printf("%-8d %-14.6f %-14.6f %-14.6f %s\n", cutoffs[c],
+               times[0], times[1], times[2], ok ? "✓" : "✗");
     }
     
+    small_sort_mode = saved_mode;
+    small_sort_threshold = saved_threshold;
+    free(original);
     free(test_data);
 }
 
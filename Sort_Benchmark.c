@@ -0,0 +1,482 @@
+// Reproducible benchmark harness for every sorter in the repository.
+//
+// Build:
+//   gcc -std=c99 -Wall -Wextra -O2 -pthread Sort_Benchmark.c -o sort_benchmark
+//
+// Each (sorter, dataset, size) cell is generated from a fixed seed, sorted
+// --warmup times untimed and then --trials times against a monotonic
+// clock. Every trial is checked with is_sorted(). Results are reported as
+// min/median/p99/mean seconds plus ns per element, in table, CSV or JSON.
+//
+// Usage: sort_benchmark [--min-size N] [--max-size N] [--trials N]
+//                       [--warmup N] [--seed N] [--threads N]
+//                       [--sorters a,b,...] [--datasets a,b,...]
+//                       [--format table|csv|json] [--output FILE]
+//
+// Built with -DENABLE_PERF_COUNTERS, each cell also gets one extra
+// untimed run under the hardware counters from PerfCounters.h, and the
+// per-element counts are appended to every row.
+
+#define QUICKSORT_NO_MAIN
+#include "QuickSort_Optimized.c"
+
+#define HEAPSORT_NO_MAIN
+#define print_array heap_print_array
+#include "HeapSort_PriorityQueue_Optimized.c"
+#undef print_array
+
+#define MAX_TRIALS 1000
+#define DUPLICATE_SENSITIVE_LIMIT 100000
+
+typedef void (*SortKernel)(int arr[], int n);
+
+typedef struct {
+    const char* name;
+    SortKernel run;
+    int max_size;              // Larger inputs are skipped (quadratic sorts)
+    bool duplicate_sensitive;  // Lomuto-based: quadratic on duplicate-heavy data
+} SortEntry;
+
+typedef struct {
+    const char* name;
+    bool duplicate_heavy;  // Few distinct keys; see DUPLICATE_SENSITIVE_LIMIT
+} DatasetEntry;
+
+typedef enum {
+    FORMAT_TABLE,
+    FORMAT_CSV,
+    FORMAT_JSON
+} OutputFormat;
+
+typedef struct {
+    long min_size;
+    long max_size;
+    int trials;
+    int warmup;
+    unsigned int seed;
+    int threads;
+    const char* sorters;
+    const char* datasets;
+    OutputFormat format;
+    const char* output;
+} BenchmarkOptions;
+
+typedef struct {
+    double min;
+    double median;
+    double p99;
+    double mean;
+#ifdef ENABLE_PERF_COUNTERS
+    double counters[PERF_COUNTER_COUNT];  // Per element; < 0 if unavailable
+#endif
+} TrialStats;
+
+// Thread count used by the parallel sorter wrappers
+int benchmark_threads = 0;
+
+// Sorter wrappers with a common (arr, n) signature
+void run_quicksort_recursive(int arr[], int n) { quicksort_recursive(arr, 0, n - 1, MEDIAN_OF_THREE); }
+void run_quicksort_iterative(int arr[], int n) { quicksort_iterative(arr, 0, n - 1, MEDIAN_OF_THREE); }
+void run_quicksort_hybrid(int arr[], int n) { quicksort_hybrid(arr, 0, n - 1, MEDIAN_OF_THREE); }
+void run_quicksort_block(int arr[], int n) { quicksort_block(arr, 0, n - 1, MEDIAN_OF_THREE); }
+void run_quicksort_introsort(int arr[], int n) { quicksort_introsort(arr, 0, n - 1, MEDIAN_OF_THREE); }
+void run_quicksort_three_way(int arr[], int n) { quicksort_three_way(arr, 0, n - 1, MEDIAN_OF_THREE); }
+void run_quicksort_parallel(int arr[], int n) { quicksort_parallel(arr, 0, n - 1, MEDIAN_OF_THREE, benchmark_threads); }
+void run_merge_sort_parallel(int arr[], int n) { merge_sort_parallel(arr, 0, n - 1, benchmark_threads); }
+void run_sample_sort(int arr[], int n) { sample_sort(arr, 0, n - 1, benchmark_threads); }
+void run_timsort(int arr[], int n) { timsort(arr, 0, n - 1); }
+void run_radix_sort_8(int arr[], int n) { radix_sort(arr, 0, n - 1, 8); }
+void run_radix_sort_11(int arr[], int n) { radix_sort(arr, 0, n - 1, 11); }
+void run_radix_sort_16(int arr[], int n) { radix_sort(arr, 0, n - 1, 16); }
+void run_heap_sort(int arr[], int n) { heap_sort_ascending(arr, n); }
+void run_heap_sort_parallel(int arr[], int n) { heap_sort_ascending_parallel(arr, n, benchmark_threads); }
+void run_insertion_sort(int arr[], int n) { insertion_sort(arr, 0, n - 1); }
+
+SortEntry sorters[] = {
+    {"quicksort_recursive", run_quicksort_recursive, MAX_PARALLEL_SIZE, true},
+    {"quicksort_iterative", run_quicksort_iterative, MAX_PARALLEL_SIZE, true},
+    {"quicksort_hybrid", run_quicksort_hybrid, MAX_PARALLEL_SIZE, true},
+    {"quicksort_block", run_quicksort_block, MAX_PARALLEL_SIZE, false},
+    {"quicksort_introsort", run_quicksort_introsort, MAX_PARALLEL_SIZE, false},
+    {"quicksort_three_way", run_quicksort_three_way, MAX_PARALLEL_SIZE, false},
+    {"quicksort_parallel", run_quicksort_parallel, MAX_PARALLEL_SIZE, false},
+    {"merge_sort_parallel", run_merge_sort_parallel, MAX_PARALLEL_SIZE, false},
+    {"sample_sort", run_sample_sort, MAX_PARALLEL_SIZE, false},
+    {"timsort", run_timsort, MAX_PARALLEL_SIZE, false},
+    {"radix_sort_8", run_radix_sort_8, MAX_PARALLEL_SIZE, false},
+    {"radix_sort_11", run_radix_sort_11, MAX_PARALLEL_SIZE, false},
+    {"radix_sort_16", run_radix_sort_16, MAX_PARALLEL_SIZE, false},
+    {"heap_sort", run_heap_sort, MAX_PARALLEL_SIZE, false},
+    {"heap_sort_parallel", run_heap_sort_parallel, MAX_PARALLEL_SIZE, false},
+    {"insertion_sort", run_insertion_sort, 50000, false},
+};
+
+// "random" draws from 1000 values, so it is as duplicate-heavy as few_unique
+DatasetEntry datasets[] = {
+    {"full_range", false},
+    {"random", true},
+    {"ascending", false},
+    {"descending", false},
+    {"few_unique", true},
+    {"nearly_sorted", false},
+};
+
+// Function prototypes
+void print_usage(const char* program);
+bool parse_options(int argc, char* argv[], BenchmarkOptions* options);
+bool list_contains(const char* list, const char* name);
+int compare_doubles(const void* a, const void* b);
+TrialStats compute_stats(double times[], int count);
+void print_header(FILE* out, OutputFormat format);
+void print_result(FILE* out, OutputFormat format, bool first, const char* sorter,
+                  const char* dataset, long size, int trials, TrialStats stats, bool sorted);
+void print_footer(FILE* out, OutputFormat format);
+void print_counters(FILE* out, OutputFormat format, TrialStats stats);
+
+int main(int argc, char* argv[]) {
+    BenchmarkOptions options;
+    
+    if (!parse_options(argc, argv, &options)) {
+        print_usage(argv[0]);
+        return 1;
+    }
+    
+    benchmark_threads = options.threads;
+    
+    FILE* out = stdout;
+    if (options.output) {
+        out = fopen(options.output, "w");
+        if (!out) {
+            fprintf(stderr, "Cannot open %s for writing\n", options.output);
+            return 1;
+        }
+    }
+    
+    int* original = (int*)malloc(options.max_size * sizeof(int));
+    int* work = (int*)malloc(options.max_size * sizeof(int));
+    double* times = (double*)malloc(options.trials * sizeof(double));
+    
+    if (!original || !work || !times) {
+        fprintf(stderr, "Memory allocation failed for size %ld\n", options.max_size);
+        free(original);
+        free(work);
+        free(times);
+        if (out != stdout) fclose(out);
+        return 1;
+    }
+    
+    int num_sorters = sizeof(sorters) / sizeof(sorters[0]);
+    int num_datasets = sizeof(datasets) / sizeof(datasets[0]);
+    bool first = true;
+    
+    print_header(out, options.format);
+    
+    for (long size = options.min_size; size <= options.max_size; size *= 10) {
+        for (int d = 0; d < num_datasets; d++) {
+            if (!list_contains(options.datasets, datasets[d].name)) continue;
+            
+            // Same seed per (dataset, size) so every sorter sees identical input
+            srand(options.seed + (unsigned int)size + 7919u * (unsigned int)d);
+            generate_test_data(original, (int)size, datasets[d].name);
+            
+            for (int k = 0; k < num_sorters; k++) {
+                SortEntry* entry = &sorters[k];
+                
+                if (!list_contains(options.sorters, entry->name)) continue;
+                if (size > entry->max_size) continue;
+                if (entry->duplicate_sensitive && datasets[d].duplicate_heavy &&
+                    size > DUPLICATE_SENSITIVE_LIMIT) continue;
+                
+                for (int w = 0; w < options.warmup; w++) {
+                    memcpy(work, original, size * sizeof(int));
+                    entry->run(work, (int)size);
+                }
+                
+                bool sorted = true;
+                for (int t = 0; t < options.trials; t++) {
+                    memcpy(work, original, size * sizeof(int));
+                    double start = get_wall_time();
+                    entry->run(work, (int)size);
+                    times[t] = get_wall_time() - start;
+                    sorted = sorted && is_sorted(work, (int)size);
+                }
+                
+                TrialStats stats = compute_stats(times, options.trials);
+                
+#ifdef ENABLE_PERF_COUNTERS
+                PerfCounters counters;
+                memcpy(work, original, size * sizeof(int));
+                perf_counters_open(&counters);
+                perf_counters_start(&counters);
+                entry->run(work, (int)size);
+                perf_counters_stop(&counters);
+                perf_counters_close(&counters);
+                
+                for (int c = 0; c < PERF_COUNTER_COUNT; c++) {
+                    stats.counters[c] = counters.values[c] < 0 ? -1 : counters.values[c] / (double)size;
+                }
+#endif
+                
+                print_result(out, options.format, first, entry->name, datasets[d].name,
+                             size, options.trials, stats, sorted);
+                first = false;
+                fflush(out);
+            }
+        }
+    }
+    
+    print_footer(out, options.format);
+    
+    free(original);
+    free(work);
+    free(times);
+    if (out != stdout) fclose(out);
+    
+    return 0;
+}
+
+void print_usage(const char* program) {
+    fprintf(stderr,
+            "Usage: %s [options]\n"
+            "  --min-size N     smallest input size (default 1000)\n"
+            "  --max-size N     largest input size, up to %d (default 1000000)\n"
+            "                   sizes step by powers of ten from min to max\n"
+            "  --trials N       timed trials per cell (default 5)\n"
+            "  --warmup N       untimed warm-up runs per cell (default 1)\n"
+            "  --seed N         base seed for input generation (default %u)\n"
+            "  --threads N      threads for parallel sorters, 0 = all CPUs (default 0)\n"
+            "  --sorters LIST   comma-separated sorter names (default all)\n"
+            "  --datasets LIST  comma-separated datasets (default all)\n"
+            "  --format F       table, csv or json (default table)\n"
+            "  --output FILE    write results to FILE instead of stdout\n",
+            program, MAX_PARALLEL_SIZE, BENCHMARK_SEED);
+    
+    fprintf(stderr, "Sorters:");
+    for (size_t i = 0; i < sizeof(sorters) / sizeof(sorters[0]); i++) {
+        fprintf(stderr, " %s", sorters[i].name);
+    }
+    fprintf(stderr, "\nDatasets:");
+    for (size_t i = 0; i < sizeof(datasets) / sizeof(datasets[0]); i++) {
+        fprintf(stderr, " %s", datasets[i].name);
+    }
+    fprintf(stderr, "\n");
+}
+
+bool parse_options(int argc, char* argv[], BenchmarkOptions* options) {
+    options->min_size = 1000;
+    options->max_size = 1000000;
+    options->trials = 5;
+    options->warmup = 1;
+    options->seed = BENCHMARK_SEED;
+    options->threads = 0;
+    options->sorters = NULL;
+    options->datasets = NULL;
+    options->format = FORMAT_TABLE;
+    options->output = NULL;
+    
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : NULL;
+        
+        if (strcmp(arg, "--help") == 0 || strcmp(arg, "-h") == 0) {
+            return false;
+        }
+        if (!value) {
+            fprintf(stderr, "Missing value for %s\n", arg);
+            return false;
+        }
+        i++;
+        
+        if (strcmp(arg, "--min-size") == 0) {
+            options->min_size = atol(value);
+        } else if (strcmp(arg, "--max-size") == 0) {
+            options->max_size = atol(value);
+        } else if (strcmp(arg, "--trials") == 0) {
+            options->trials = atoi(value);
+        } else if (strcmp(arg, "--warmup") == 0) {
+            options->warmup = atoi(value);
+        } else if (strcmp(arg, "--seed") == 0) {
+            options->seed = (unsigned int)strtoul(value, NULL, 10);
+        } else if (strcmp(arg, "--threads") == 0) {
+            options->threads = atoi(value);
+        } else if (strcmp(arg, "--sorters") == 0) {
+            options->sorters = value;
+        } else if (strcmp(arg, "--datasets") == 0) {
+            options->datasets = value;
+        } else if (strcmp(arg, "--output") == 0) {
+            options->output = value;
+        } else if (strcmp(arg, "--format") == 0) {
+            if (strcmp(value, "table") == 0) {
+                options->format = FORMAT_TABLE;
+            } else if (strcmp(value, "csv") == 0) {
+                options->format = FORMAT_CSV;
+            } else if (strcmp(value, "json") == 0) {
+                options->format = FORMAT_JSON;
+            } else {
+                fprintf(stderr, "Unknown format: %s\n", value);
+                return false;
+            }
+        } else {
+            fprintf(stderr, "Unknown option: %s\n", arg);
+            return false;
+        }
+    }
+    
+    if (options->min_size < 1 || options->max_size < options->min_size ||
+        options->max_size > MAX_PARALLEL_SIZE) {
+        fprintf(stderr, "Sizes must satisfy 1 <= min <= max <= %d\n", MAX_PARALLEL_SIZE);
+        return false;
+    }
+    if (options->trials < 1 || options->trials > MAX_TRIALS || options->warmup < 0) {
+        fprintf(stderr, "Trials must be 1..%d and warm-up non-negative\n", MAX_TRIALS);
+        return false;
+    }
+    
+    return true;
+}
+
+// NULL list means "everything"; otherwise match a whole comma-separated item
+bool list_contains(const char* list, const char* name) {
+    if (!list) return true;
+    
+    size_t len = strlen(name);
+    const char* item = list;
+    
+    while (*item) {
+        const char* end = strchr(item, ',');
+        size_t item_len = end ? (size_t)(end - item) : strlen(item);
+        
+        if (item_len == len && strncmp(item, name, len) == 0) {
+            return true;
+        }
+        if (!end) break;
+        item = end + 1;
+    }
+    
+    return false;
+}
+
+int compare_doubles(const void* a, const void* b) {
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+// Median is the middle sample (mean of the two middle ones for even
+// counts); p99 uses the nearest-rank method
+TrialStats compute_stats(double times[], int count) {
+    TrialStats stats;
+    double sum = 0;
+    
+    qsort(times, count, sizeof(double), compare_doubles);
+    
+    for (int i = 0; i < count; i++) {
+        sum += times[i];
+    }
+    
+    int rank = (99 * count + 99) / 100;
+    
+    stats.min = times[0];
+    stats.median = count % 2 ? times[count / 2]
+                             : (times[count / 2 - 1] + times[count / 2]) / 2;
+    stats.p99 = times[rank - 1];
+    stats.mean = sum / count;
+    
+    return stats;
+}
+
+void print_header(FILE* out, OutputFormat format) {
+    switch (format) {
+        case FORMAT_TABLE:
+            fprintf(out, "%-20s %-13s %10s %6s %12s %12s %12s %10s %-3s",
+                    "Sorter", "Dataset", "Size", "Trials", "Median (s)",
+                    "P99 (s)", "Min (s)", "ns/elem", "OK");
+#ifdef ENABLE_PERF_COUNTERS
+            for (int c = 0; c < PERF_COUNTER_COUNT; c++) {
+                fprintf(out, " %13s", perf_counter_names[c]);
+            }
+#endif
+            fprintf(out, "\n");
+            break;
+        case FORMAT_CSV:
+            fprintf(out, "sorter,dataset,size,trials,min_s,median_s,p99_s,mean_s,ns_per_element,sorted");
+#ifdef ENABLE_PERF_COUNTERS
+            for (int c = 0; c < PERF_COUNTER_COUNT; c++) {
+                fprintf(out, ",%s_per_element", perf_counter_names[c]);
+            }
+#endif
+            fprintf(out, "\n");
+            break;
+        case FORMAT_JSON:
+            fprintf(out, "[\n");
+            break;
+    }
+}
+
+void print_result(FILE* out, OutputFormat format, bool first, const char* sorter,
+                  const char* dataset, long size, int trials, TrialStats stats, bool sorted) {
+    double ns_per_element = stats.median * 1e9 / (double)size;
+    
+    switch (format) {
+        case FORMAT_TABLE:
+            fprintf(out, "%-20s %-13s %10ld %6d %12.6f %12.6f %12.6f %10.2f %-3s",
+                    sorter, dataset, size, trials, stats.median, stats.p99,
+                    stats.min, ns_per_element, sorted ? "yes" : "NO");
+            print_counters(out, format, stats);
+            fprintf(out, "\n");
+            break;
+        case FORMAT_CSV:
+            fprintf(out, "%s,%s,%ld,%d,%.9f,%.9f,%.9f,%.9f,%.3f,%s",
+                    sorter, dataset, size, trials, stats.min, stats.median,
+                    stats.p99, stats.mean, ns_per_element, sorted ? "true" : "false");
+            print_counters(out, format, stats);
+            fprintf(out, "\n");
+            break;
+        case FORMAT_JSON:
+            fprintf(out, "%s  {\"sorter\": \"%s\", \"dataset\": \"%s\", \"size\": %ld, "
+                         "\"trials\": %d, \"min_s\": %.9f, \"median_s\": %.9f, "
+                         "\"p99_s\": %.9f, \"mean_s\": %.9f, \"ns_per_element\": %.3f, "
+                         "\"sorted\": %s",
+                    first ? "" : ",\n", sorter, dataset, size, trials, stats.min,
+                    stats.median, stats.p99, stats.mean, ns_per_element,
+                    sorted ? "true" : "false");
+            print_counters(out, format, stats);
+            fprintf(out, "}");
+            break;
+    }
+}
+
+// Appends the per-element hardware counters to a row; prints nothing
+// unless built with ENABLE_PERF_COUNTERS
+void print_counters(FILE* out, OutputFormat format, TrialStats stats) {
+#ifdef ENABLE_PERF_COUNTERS
+    for (int c = 0; c < PERF_COUNTER_COUNT; c++) {
+        double value = stats.counters[c];
+        
+        switch (format) {
+            case FORMAT_TABLE:
+                if (value < 0) fprintf(out, " %13s", "n/a");
+                else fprintf(out, " %13.3f", value);
+                break;
+            case FORMAT_CSV:
+                if (value < 0) fprintf(out, ",");
+                else fprintf(out, ",%.4f", value);
+                break;
+            case FORMAT_JSON:
+                if (value < 0) fprintf(out, ", \"%s_per_element\": null", perf_counter_names[c]);
+                else fprintf(out, ", \"%s_per_element\": %.4f", perf_counter_names[c], value);
+                break;
+        }
+    }
+#else
+    (void)out;
+    (void)format;
+    (void)stats;
+#endif
+}
+
+void print_footer(FILE* out, OutputFormat format) {
+    if (format == FORMAT_JSON) {
+        fprintf(out, "\n]\n");
+    }
+}